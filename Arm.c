@@ -3,6 +3,8 @@
  * Production-ready testing with edge cases and performance validation
  */
 
+#define _GNU_SOURCE                 // fileno(), sockets and sched_getaffinity() for the flight recorder, exporter and pinning tests
+
 #include "hypercomplex.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,6 +12,12 @@
 #include <math.h>
 #include <assert.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 // Test framework macros
 #define TEST_ASSERT(condition, message) \
@@ -202,6 +210,219 @@ int test_null_pointer_handling() {
     return 1;
 }
 
+int test_batch_operations() {
+    enum { COUNT = 37 };                 // Odd length exercises vector tails
+    quaternion_t a[COUNT], b[COUNT], out[COUNT], expected;
+    
+    for (int i = 0; i < COUNT; i++) {
+        quaternion_init(&a[i], 1.0f + i, 0.5f * i, -0.25f * i, 2.0f);
+        quaternion_init(&b[i], 0.5f, 1.0f - i, 0.125f * i, -1.0f);
+    }
+    
+    TEST_ASSERT(quaternion_multiply_batch(a, b, out, COUNT) == HC_SUCCESS, "Batch multiply should succeed");
+    for (int i = 0; i < COUNT; i++) {
+        quaternion_multiply(&a[i], &b[i], &expected);
+        TEST_ASSERT_FLOAT_EQ(expected.w, out[i].w, 1e-3f, "Batch multiply w matches scalar");
+        TEST_ASSERT_FLOAT_EQ(expected.z, out[i].z, 1e-3f, "Batch multiply z matches scalar");
+    }
+    
+    TEST_ASSERT(quaternion_add_batch(a, b, out, COUNT) == HC_SUCCESS, "Batch add should succeed");
+    TEST_ASSERT_FLOAT_EQ(a[7].x + b[7].x, out[7].x, 1e-6f, "Batch add x component");
+    
+    TEST_ASSERT(quaternion_conjugate_batch(a, out, COUNT) == HC_SUCCESS, "Batch conjugate should succeed");
+    TEST_ASSERT_FLOAT_EQ(-a[3].y, out[3].y, 1e-6f, "Batch conjugate y component");
+    
+    // In place, with one zero element that must be reported but not stop the batch
+    quaternion_init(&a[5], 0.0f, 0.0f, 0.0f, 0.0f);
+    TEST_ASSERT(quaternion_normalize_batch(a, a, COUNT) == HC_ERROR_DIVIDE_ZERO, "Zero element should be reported");
+    TEST_ASSERT_FLOAT_EQ(1.0f, quaternion_norm(&a[COUNT - 1]), 1e-6f, "Other elements are normalized");
+    TEST_ASSERT_FLOAT_EQ(0.0f, a[5].w, 1e-6f, "Zero element is left unchanged");
+    
+    TEST_ASSERT(quaternion_multiply_batch(NULL, b, out, COUNT) == HC_ERROR_NULL_PTR, "Null input in batch");
+    TEST_ASSERT(quaternion_normalize_batch(a, NULL, COUNT) == HC_ERROR_NULL_PTR, "Null output in batch");
+    
+    void* aligned = hc_aligned_alloc(1000, 64);
+    TEST_ASSERT(aligned != NULL && ((uintptr_t)aligned & 63) == 0, "Aligned allocation");
+    hc_aligned_free(aligned);
+    
+    return 1;
+}
+
+int test_aligned_batch() {
+    enum { COUNT = 37 };
+    quaternion_a16_t* a = hc_quaternion_array_alloc(COUNT);
+    quaternion_a16_t* b = hc_quaternion_array_alloc(COUNT);
+    quaternion_a16_t* out = hc_quaternion_array_alloc(COUNT + 1);
+    quaternion_t expected[COUNT];
+    
+    TEST_ASSERT(a && b && out, "Array allocation should succeed");
+    TEST_ASSERT(((uintptr_t)a & (HC_ARRAY_ALIGNMENT - 1)) == 0, "Arrays should start on a cache line");
+    TEST_ASSERT(hc_quaternion_array_alloc(0) == NULL, "Empty array should return NULL");
+    
+    for (int i = 0; i < COUNT; i++) {
+        quaternion_init((quaternion_t*)&a[i], 1.0f + i, 0.5f * i, -0.25f * i, 2.0f);
+        quaternion_init((quaternion_t*)&b[i], 0.5f, 1.0f - i, 0.125f * i, -1.0f);
+    }
+    
+    // Aligned kernels must agree exactly with the unaligned ones
+    quaternion_multiply_batch((const quaternion_t*)a, (const quaternion_t*)b, expected, COUNT);
+    TEST_ASSERT(quaternion_multiply_batch_aligned(a, b, out, COUNT) == HC_SUCCESS, "Aligned multiply should succeed");
+    TEST_ASSERT(memcmp(expected, out, sizeof(expected)) == 0, "Aligned multiply matches unaligned");
+    
+    quaternion_add_batch((const quaternion_t*)a, (const quaternion_t*)b, expected, COUNT);
+    TEST_ASSERT(quaternion_add_batch_aligned(a, b, out, COUNT) == HC_SUCCESS, "Aligned add should succeed");
+    TEST_ASSERT(memcmp(expected, out, sizeof(expected)) == 0, "Aligned add matches unaligned");
+    
+    quaternion_conjugate_batch((const quaternion_t*)a, expected, COUNT);
+    TEST_ASSERT(quaternion_conjugate_batch_aligned(a, out, COUNT) == HC_SUCCESS, "Aligned conjugate should succeed");
+    TEST_ASSERT(memcmp(expected, out, sizeof(expected)) == 0, "Aligned conjugate matches unaligned");
+    
+    quaternion_normalize_batch((const quaternion_t*)a, expected, COUNT);
+    TEST_ASSERT(quaternion_normalize_batch_aligned(a, out, COUNT) == HC_SUCCESS, "Aligned normalize should succeed");
+    TEST_ASSERT(memcmp(expected, out, sizeof(expected)) == 0, "Aligned normalize matches unaligned");
+    
+    // Misaligned pointers are rejected before any element is written
+    const quaternion_a16_t* skewed = (const quaternion_a16_t*)((const char*)a + 4);
+    TEST_ASSERT(quaternion_add_batch_aligned(skewed, b, out, COUNT - 1) == HC_ERROR_INVALID_DATA,
+                "Misaligned input should be rejected");
+    TEST_ASSERT(quaternion_conjugate_batch_aligned(NULL, out, COUNT) == HC_ERROR_NULL_PTR, "Null input in aligned batch");
+    
+    hc_quaternion_array_free(a);
+    hc_quaternion_array_free(b);
+    hc_quaternion_array_free(out);
+    return 1;
+}
+
+int test_reductions() {
+    enum { COUNT = 3000 };
+    static quaternion_t q[COUNT];
+    quaternion_t serial, split, expected;
+    
+    for (int i = 0; i < COUNT; i++) {
+        float angle = 0.001f * (float)(i % 17);
+        quaternion_init(&q[i], cosf(angle), sinf(angle) * 0.6f, 0.0f, sinf(angle) * 0.8f);
+    }
+    
+    TEST_ASSERT(quaternion_sum(q, 3, &serial) == HC_SUCCESS, "Sum should succeed");
+    quaternion_add(&q[0], &q[1], &expected);
+    quaternion_add(&expected, &q[2], &expected);
+    TEST_ASSERT(memcmp(&expected, &serial, sizeof(expected)) == 0, "Short sum matches quaternion_add");
+    
+    // The product keeps its order: q[1] * q[2] differs from q[2] * q[1]
+    quaternion_t pair[2];
+    quaternion_init(&pair[0], 0.0f, 1.0f, 0.0f, 0.0f);
+    quaternion_init(&pair[1], 0.0f, 0.0f, 1.0f, 0.0f);
+    TEST_ASSERT(quaternion_product(pair, 2, &serial) == HC_SUCCESS, "Product should succeed");
+    TEST_ASSERT_FLOAT_EQ(1.0f, serial.z, 1e-6f, "i * j = k");
+    
+    TEST_ASSERT(quaternion_sum(NULL, 0, &serial) == HC_SUCCESS, "Empty sum should succeed");
+    TEST_ASSERT_FLOAT_EQ(0.0f, serial.w, 1e-6f, "Empty sum is zero");
+    TEST_ASSERT(quaternion_product(NULL, 0, &serial) == HC_SUCCESS, "Empty product should succeed");
+    TEST_ASSERT_FLOAT_EQ(1.0f, serial.w, 1e-6f, "Empty product is the identity");
+    TEST_ASSERT(quaternion_sum(NULL, 4, &serial) == HC_ERROR_NULL_PTR, "Null input in sum");
+    TEST_ASSERT(quaternion_product(q, 4, NULL) == HC_ERROR_NULL_PTR, "Null result in product");
+    
+    // Split across the pool, results must match the inline run up to rounding
+    hc_tuning_t saved, t;
+    hc_tuning_get(&saved);
+    hc_tuning_default(&t);
+    hc_tuning_set(&t);
+    quaternion_sum(q, COUNT, &serial);
+    quaternion_product(q, COUNT, &expected);
+    
+    t.threads = 4;
+    t.chunk_elements = 64;
+    hc_tuning_set(&t);
+    TEST_ASSERT(quaternion_sum(q, COUNT, &split) == HC_SUCCESS, "Split sum should succeed");
+    TEST_ASSERT_FLOAT_EQ(serial.w, split.w, 1e-2f, "Split sum should match inline");
+    TEST_ASSERT_FLOAT_EQ(serial.z, split.z, 1e-2f, "Split sum should match inline");
+    TEST_ASSERT(quaternion_product(q, COUNT, &split) == HC_SUCCESS, "Split product should succeed");
+    TEST_ASSERT_FLOAT_EQ(expected.w, split.w, 1e-4f, "Split product should match inline");
+    TEST_ASSERT_FLOAT_EQ(expected.x, split.x, 1e-4f, "Split product should match inline");
+    TEST_ASSERT_FLOAT_EQ(expected.z, split.z, 1e-4f, "Split product should match inline");
+    
+    hc_tuning_set(&saved);
+    return 1;
+}
+
+int test_unit_quaternions() {
+    quaternion_t raw, scaled, product;
+    unit_quaternion_t u, inv, turn, mid, key;
+    float h = sqrtf(0.5f);
+    float v[3] = { 1.0f, 0.0f, 0.0f }, out[3], expected[3];
+    
+    quaternion_init(&raw, 1.0f, 2.0f, 3.0f, 4.0f);
+    TEST_ASSERT(unit_quaternion_make(&raw, &u) == HC_SUCCESS, "Unit make should succeed");
+    TEST_ASSERT_FLOAT_EQ(1.0f, quaternion_norm(&u.q), 1e-6f, "Unit make normalizes");
+    
+    quaternion_init(&scaled, 0.0f, 0.0f, 0.0f, 0.0f);
+    TEST_ASSERT(unit_quaternion_make(&scaled, &inv) == HC_ERROR_DIVIDE_ZERO, "Zero has no unit quaternion");
+    quaternion_init(&scaled, NAN, 0.0f, 0.0f, 0.0f);
+    TEST_ASSERT(unit_quaternion_make(&scaled, &inv) == HC_ERROR_INVALID_DATA, "NaN is rejected");
+    TEST_ASSERT(unit_quaternion_make(NULL, &inv) == HC_ERROR_NULL_PTR, "Null input in unit make");
+    
+    // Finite inputs whose squared norm overflows are scaled first, not zeroed
+    quaternion_init(&scaled, 1e20f, 1e20f, 0.0f, 0.0f);
+    TEST_ASSERT(unit_quaternion_make(&scaled, &inv) == HC_SUCCESS, "Huge input has a unit quaternion");
+    TEST_ASSERT_FLOAT_EQ(h, inv.q.w, 1e-6f, "Huge input keeps its direction");
+    TEST_ASSERT_FLOAT_EQ(h, inv.q.x, 1e-6f, "Huge input keeps its direction");
+    TEST_ASSERT(quaternion_inverse(&scaled, &product) == HC_SUCCESS, "Huge input has an inverse");
+    TEST_ASSERT_FLOAT_EQ(0.5f, product.w * 1e20f, 1e-6f, "Huge inverse is conj(q) / |q|^2");
+    TEST_ASSERT_FLOAT_EQ(-0.5f, product.x * 1e20f, 1e-6f, "Huge inverse is conj(q) / |q|^2");
+    quaternion_init(&scaled, 3e38f, -3e38f, 3e38f, 1.0f);
+    TEST_ASSERT(quaternion_rotate(&scaled, v, out) == HC_SUCCESS, "Rotation by a huge input is defined");
+    TEST_ASSERT(isfinite(out[0]) && isfinite(out[1]) && isfinite(out[2]), "Rotation by a huge input stays finite");
+    
+    // Inverse is the conjugate, and undoes the rotation
+    TEST_ASSERT(unit_quaternion_inverse(&u, &inv) == HC_SUCCESS, "Unit inverse should succeed");
+    TEST_ASSERT(inv.q.w == u.q.w && inv.q.x == -u.q.x && inv.q.z == -u.q.z, "Unit inverse is the conjugate");
+    quaternion_multiply(&u.q, &inv.q, &product);
+    TEST_ASSERT_FLOAT_EQ(1.0f, product.w, 1e-6f, "q * q^-1 is the identity");
+    TEST_ASSERT(quaternion_inverse(&raw, &product) == HC_SUCCESS, "General inverse should succeed");
+    quaternion_multiply(&raw, &product, &product);
+    TEST_ASSERT_FLOAT_EQ(1.0f, product.w, 1e-6f, "General q * q^-1 is the identity");
+    TEST_ASSERT_FLOAT_EQ(0.0f, product.y, 1e-6f, "General q * q^-1 is the identity");
+    
+    // A quarter turn about z takes x to y; the general call normalizes first
+    quaternion_init(&turn.q, h, 0.0f, 0.0f, h);
+    TEST_ASSERT(unit_quaternion_rotate(&turn, v, out) == HC_SUCCESS, "Unit rotate should succeed");
+    TEST_ASSERT_FLOAT_EQ(0.0f, out[0], 1e-6f, "Rotated x component");
+    TEST_ASSERT_FLOAT_EQ(1.0f, out[1], 1e-6f, "Rotated y component");
+    
+    v[1] = -2.0f;
+    v[2] = 0.5f;
+    unit_quaternion_rotate(&u, v, expected);
+    quaternion_init(&scaled, 3.0f * raw.w, 3.0f * raw.x, 3.0f * raw.y, 3.0f * raw.z);
+    TEST_ASSERT(quaternion_rotate(&scaled, v, out) == HC_SUCCESS, "General rotate should succeed");
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_FLOAT_EQ(expected[i], out[i], 1e-5f, "General rotate matches unit rotate");
+    }
+    
+    // SLERP: ends, midpoint, and the short way round for -b
+    unit_quaternion_t id;
+    quaternion_identity(&id.q);
+    TEST_ASSERT(unit_quaternion_slerp(&id, &turn, 0.0f, &mid) == HC_SUCCESS, "Unit slerp should succeed");
+    TEST_ASSERT_FLOAT_EQ(1.0f, mid.q.w, 1e-6f, "Slerp at 0 is the start");
+    unit_quaternion_slerp(&id, &turn, 1.0f, &mid);
+    TEST_ASSERT_FLOAT_EQ(h, mid.q.z, 1e-6f, "Slerp at 1 is the end");
+    unit_quaternion_slerp(&id, &turn, 0.5f, &mid);
+    TEST_ASSERT_FLOAT_EQ(cosf(0.39269908f), mid.q.w, 1e-6f, "Slerp midpoint is an eighth turn");
+    TEST_ASSERT_FLOAT_EQ(sinf(0.39269908f), mid.q.z, 1e-6f, "Slerp midpoint is an eighth turn");
+    quaternion_init(&scaled, -2.0f * h, 0.0f, 0.0f, -2.0f * h);
+    TEST_ASSERT(quaternion_slerp(&id.q, &scaled, 0.5f, &product) == HC_SUCCESS, "General slerp should succeed");
+    TEST_ASSERT_FLOAT_EQ(mid.q.w, product.w, 1e-6f, "General slerp takes the short way round");
+    TEST_ASSERT_FLOAT_EQ(mid.q.z, product.z, 1e-6f, "General slerp takes the short way round");
+    
+    // Keys are unit already; a drifted product is pulled back without a sqrt
+    unit_quaternion_generate_key(&key, 12345ULL);
+    TEST_ASSERT_FLOAT_EQ(1.0f, quaternion_norm(&key.q), 1e-6f, "Generated keys are unit");
+    quaternion_init(&u.q, 1.0005f * u.q.w, 1.0005f * u.q.x, 1.0005f * u.q.y, 1.0005f * u.q.z);
+    unit_quaternion_renormalize(&u);
+    TEST_ASSERT_FLOAT_EQ(1.0f, quaternion_norm(&u.q), 1e-6f, "Renormalize restores norm 1");
+    
+    return 1;
+}
+
 int test_encryption_decryption() {
     const char* test_data = "Hello, hypercomplex world! This is test data.";
     size_t data_len = strlen(test_data);
@@ -210,7 +431,7 @@ int test_encryption_decryption() {
     quaternion_generate_key(&key, 12345ULL);
     
     // Allocate buffers
-    size_t cipher_len = data_len + sizeof(hypercomplex_header_t) + 32; // Extra space
+    size_t cipher_len = hypercomplex_cipher_length(data_len);
     uint8_t* ciphertext = malloc(cipher_len);
     uint8_t* decrypted = malloc(data_len + 16);
     size_t decrypted_len = data_len + 16;
@@ -236,6 +457,133 @@ int test_encryption_decryption() {
     return 1;
 }
 
+int test_decrypt_exact() {
+    // Bytes that read as NaN, infinity and denormal floats, at lengths ending mid-block
+    enum { LENGTH = 4099 };
+    static uint8_t message[LENGTH], decrypted[LENGTH + 1], ciphertext[2 * LENGTH + 256];
+    const size_t lengths[] = { 1, 7, 8, 9, LENGTH };
+    hc_tuning_t saved, t;
+    
+    for (size_t i = 0; i < LENGTH; i++) message[i] = (uint8_t)(i * 131 + (i >> 8));
+    memcpy(message, "\x00\x00\xc0\x7f\x00\x00\x80\xff\x01\x00\x00\x00", 12);
+    
+    hc_tuning_get(&saved);
+    hc_tuning_default(&t);
+    for (int split = 0; split < 2; split++) {
+        // The second pass runs the inverse on the SIMD kernels, split across the pool
+        if (split) {
+            if (hc_backend_available(HC_BACKEND_SIMD)) t.batch_backend = HC_BACKEND_SIMD;
+            t.threads = 4;
+            t.chunk_elements = 64;
+        }
+        hc_tuning_set(&t);
+        
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            quaternion_t key;
+            size_t cipher_len = sizeof(ciphertext), plain_len = sizeof(decrypted);
+            quaternion_generate_key(&key, 12345ULL + l);
+            memset(decrypted, 0xAA, sizeof(decrypted));
+            
+            TEST_ASSERT(hypercomplex_encrypt_data(message, lengths[l], &key, ciphertext, &cipher_len) == HC_SUCCESS,
+                        "Encryption should succeed");
+            TEST_ASSERT(cipher_len == hypercomplex_cipher_length(lengths[l]), "Cipher length should match the helper");
+            TEST_ASSERT(hypercomplex_decrypt_data(ciphertext, cipher_len, &key, decrypted, &plain_len) == HC_SUCCESS,
+                        "Decryption should succeed");
+            TEST_ASSERT(plain_len == lengths[l], "Decrypted length matches original");
+            TEST_ASSERT(memcmp(message, decrypted, lengths[l]) == 0, "Round trip should be byte-exact");
+            TEST_ASSERT(decrypted[lengths[l]] == 0xAA, "Decryption should not write past the message");
+            
+            plain_len = sizeof(decrypted);
+            TEST_ASSERT(hypercomplex_decrypt_data(ciphertext, cipher_len - sizeof(quaternion_t), &key, decrypted,
+                                                  &plain_len) == HC_ERROR_INVALID_DATA,
+                        "Truncated ciphertext should be rejected");
+        }
+    }
+    
+    hc_tuning_set(&saved);
+    return 1;
+}
+
+int test_buffer_pool() {
+    // Size classes round up to a power of two and keep the data cache-line aligned
+    void* small = hc_buffer_acquire(100);
+    TEST_ASSERT(small != NULL, "Acquire should succeed");
+    TEST_ASSERT(hc_buffer_capacity(small) == 128, "100 bytes should come from the 128-byte class");
+    TEST_ASSERT(((uintptr_t)small & 63) == 0, "Buffers should be 64-byte aligned");
+    
+    // The thread cache hands the last released buffer straight back; while
+    // pooled it is marked free, which is how a second release is caught
+    hc_buffer_release(small);
+    TEST_ASSERT(hc_buffer_capacity(small) == 0, "A released buffer should report no capacity");
+    void* again = hc_buffer_acquire(120);
+    TEST_ASSERT(again == small, "Released buffer should be reused");
+    TEST_ASSERT(hc_buffer_capacity(again) == 128, "A reacquired buffer should be live again");
+    hc_buffer_release(again);
+    
+    void* large = hc_buffer_acquire(HC_BUFFER_MAX_POOLED + 1);
+    TEST_ASSERT(large != NULL && hc_buffer_capacity(large) == HC_BUFFER_MAX_POOLED + 1,
+                "Oversized requests should be allocated exactly");
+    hc_buffer_release(large);
+    TEST_ASSERT(hc_buffer_acquire(0) == NULL, "Empty request should return NULL");
+    hc_buffer_release(NULL);
+    
+    quaternion_t key;
+    uint8_t message[1000];
+    void* ciphertext = NULL;
+    size_t cipher_length = 0;
+    memset(message, 0x3C, sizeof(message));
+    quaternion_generate_key(&key, 99);
+    
+    TEST_ASSERT(hypercomplex_encrypt_data_pooled(message, sizeof(message), &key, &ciphertext, &cipher_length) == HC_SUCCESS,
+                "Pooled encryption should succeed");
+    TEST_ASSERT(cipher_length == hypercomplex_cipher_length(sizeof(message)), "Cipher length should match the helper");
+    TEST_ASSERT(hc_buffer_capacity(ciphertext) >= cipher_length, "Ciphertext should fit its buffer");
+    TEST_ASSERT(((const hypercomplex_header_t*)ciphertext)->magic == 0xDEADBEEF, "Header should be written");
+    hc_buffer_release(ciphertext);
+    
+    TEST_ASSERT(hypercomplex_encrypt_data_pooled(NULL, 16, &key, &ciphertext, &cipher_length) == HC_ERROR_NULL_PTR,
+                "Errors should pass through");
+    TEST_ASSERT(ciphertext == NULL, "No buffer should be handed out on error");
+    
+    hc_buffer_trim();
+    return 1;
+}
+
+int test_huge_pages() {
+    size_t large = (size_t)4 << 20;
+    
+    TEST_ASSERT(hc_huge_pages_get() == HC_HUGE_PAGES_OFF, "Huge pages should be off by default");
+    TEST_ASSERT(hc_huge_pages_set((hc_huge_pages_t)7) == HC_ERROR_INVALID_DATA, "Unknown mode should be rejected");
+    
+    quaternion_t* plain = hc_aligned_alloc(large, 64);
+    TEST_ASSERT(plain != NULL && ((uintptr_t)plain & 63) == 0, "Plain allocation should be aligned");
+    TEST_ASSERT(hc_aligned_backing(plain) == HC_HUGE_PAGES_OFF, "Plain allocation should not use huge pages");
+    hc_aligned_free(plain);
+    
+    if (hc_huge_pages_set(HC_HUGE_PAGES_THP) == HC_ERROR_UNSUPPORTED) return 1;
+    
+    quaternion_t* q = hc_aligned_alloc(large, 64);
+    TEST_ASSERT(q != NULL && ((uintptr_t)q & 63) == 0, "THP allocation should be aligned");
+    TEST_ASSERT(hc_aligned_backing(q) == HC_HUGE_PAGES_THP, "Large allocation should request THP");
+    q[large / sizeof(quaternion_t) - 1].w = 1.0f;
+    hc_aligned_free(q);
+    
+    void* small = hc_aligned_alloc(HC_HUGE_PAGE_MIN - 1, 64);
+    TEST_ASSERT(hc_aligned_backing(small) == HC_HUGE_PAGES_OFF, "Small allocation should stay on normal pages");
+    hc_aligned_free(small);
+    
+    // hugetlbfs needs a reserved pool; without one the allocator falls back to THP
+    TEST_ASSERT(hc_huge_pages_set(HC_HUGE_PAGES_HUGETLB) == HC_SUCCESS, "HUGETLB mode should be accepted");
+    q = hc_aligned_alloc(large, 4096);
+    TEST_ASSERT(q != NULL && ((uintptr_t)q & 4095) == 0, "HUGETLB allocation should be aligned");
+    TEST_ASSERT(hc_aligned_backing(q) != HC_HUGE_PAGES_OFF, "HUGETLB allocation should use huge pages or THP");
+    memset(q, 0, large);
+    hc_aligned_free(q);
+    
+    hc_huge_pages_set(HC_HUGE_PAGES_OFF);
+    return 1;
+}
+
 int test_edge_cases() {
     quaternion_t q, result;
     
@@ -284,6 +632,761 @@ int test_performance() {
     return 1;
 }
 
+int test_benchmark_suite() {
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.iterations = 2000;
+    config.warmup = 200;
+    config.payload_bytes = 100;
+    
+    for (int op = 0; op < HC_OP_COUNT; op++) {
+        for (int mode = HC_BENCH_LATENCY; mode <= HC_BENCH_THROUGHPUT; mode++) {
+            perf_stats_t stats;
+            int ret = hc_bench_run((hc_op_t)op, (hc_bench_mode_t)mode, &config, &stats);
+            TEST_ASSERT(ret == HC_SUCCESS, "Every operation should benchmark in both modes");
+            TEST_ASSERT(stats.average_latency_ns > 0.0, "Latency should be positive");
+            TEST_ASSERT(stats.cycles_per_op > 0.0, "Cycles per op should be positive");
+            TEST_ASSERT(stats.bytes_processed > 0, "Bytes processed should be counted");
+        }
+    }
+    
+    perf_stats_t stats;
+    TEST_ASSERT(hc_bench_run(HC_OP_COUNT, HC_BENCH_LATENCY, &config, &stats) == HC_ERROR_INVALID_DATA,
+                "Unknown operation should be rejected");
+    TEST_ASSERT(hc_bench_run(HC_OP_MULTIPLY, HC_BENCH_LATENCY, &config, NULL) == HC_ERROR_NULL_PTR,
+                "Null stats should be rejected");
+    
+    return 1;
+}
+
+int test_benchmark_statistics() {
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.iterations = 500;
+    config.repetitions = 25;
+    config.warmup = 100;
+    
+    perf_stats_t stats;
+    int ret = hc_bench_run(HC_OP_NORMALIZE, HC_BENCH_THROUGHPUT, &config, &stats);
+    TEST_ASSERT(ret == HC_SUCCESS, "Repeated benchmark should succeed");
+    TEST_ASSERT(stats.repetitions == 25 && stats.samples == 25, "One sample per repetition");
+    TEST_ASSERT(stats.min_ns <= stats.median_ns, "min <= median");
+    TEST_ASSERT(stats.median_ns <= stats.p90_ns, "median <= p90");
+    TEST_ASSERT(stats.p90_ns <= stats.p99_ns, "p90 <= p99");
+    TEST_ASSERT(stats.p99_ns <= stats.p999_ns, "p99 <= p99.9");
+    TEST_ASSERT(stats.stddev_ns >= 0.0 && stats.ci95_ns >= 0.0, "Spread should be non-negative");
+    
+    // Latency runs sample every HC_BENCH_LATENCY_CALLS calls, so the percentiles describe calls
+    ret = hc_bench_run(HC_OP_ADD, HC_BENCH_LATENCY, &config, &stats);
+    TEST_ASSERT(ret == HC_SUCCESS, "Latency benchmark should succeed");
+    TEST_ASSERT(stats.samples == 25 * ((500 + HC_BENCH_LATENCY_CALLS - 1) / HC_BENCH_LATENCY_CALLS),
+                "Latency samples should be per batch of calls");
+    TEST_ASSERT(stats.min_ns <= stats.median_ns && stats.p99_ns <= stats.p999_ns, "Latency percentiles are ordered");
+    
+#ifdef __linux__
+    // Pinning to the last core in our affinity mask, which is then restored
+    cpu_set_t allowed, after;
+    TEST_ASSERT(sched_getaffinity(0, sizeof(allowed), &allowed) == 0, "Affinity mask should be readable");
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) config.cpu = cpu;
+    }
+    TEST_ASSERT(config.cpu >= 0, "Affinity mask should hold a core");
+    ret = hc_bench_run(HC_OP_ADD, HC_BENCH_LATENCY, &config, &stats);
+    TEST_ASSERT(ret == HC_SUCCESS, "Pinned run should succeed");
+    TEST_ASSERT(sched_getaffinity(0, sizeof(after), &after) == 0 && CPU_EQUAL(&allowed, &after),
+                "Pinned run should restore the affinity mask");
+#endif
+    
+    hc_bench_result_t result = { HC_OP_NORMALIZE, HC_BENCH_THROUGHPUT, config.payload_bytes, stats, NULL };
+    FILE* out = tmpfile();
+    TEST_ASSERT(out != NULL, "Temporary report file");
+    TEST_ASSERT(hc_bench_write_json(out, &result, 1) == HC_SUCCESS, "JSON report should be written");
+    TEST_ASSERT(hc_bench_write_csv(out, &result, 1) == HC_SUCCESS, "CSV report should be written");
+    TEST_ASSERT(ftell(out) > 0, "Reports should not be empty");
+    fclose(out);
+    
+    return 1;
+}
+
+int test_working_set_sweep() {
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.repetitions = 3;
+    
+    hc_bench_result_t results[8];
+    size_t count = 0;
+    
+    int ret = hc_bench_sweep(HC_OP_MULTIPLY_BATCH, &config, 4096, 65536, results, 8, &count);
+    TEST_ASSERT(ret == HC_SUCCESS, "Sweep should succeed");
+    TEST_ASSERT(count == 5, "4 KB to 64 KB is five doublings");
+    TEST_ASSERT(results[4].payload_bytes == 65536, "Last point is the maximum size");
+    TEST_ASSERT(results[0].stats.bytes_processed > 0, "Traffic should be counted");
+    
+    ret = hc_bench_sweep(HC_OP_ENCRYPT, &config, 4096, 8192, results, 8, &count);
+    TEST_ASSERT(ret == HC_SUCCESS && count == 2, "Encrypt sweep should succeed");
+    
+    TEST_ASSERT(hc_bench_sweep(HC_OP_NORM, &config, 4096, 8192, results, 8, &count) == HC_ERROR_INVALID_DATA,
+                "Scalar operations cannot be swept");
+    TEST_ASSERT(hc_cache_level((size_t)1 << 40) == 4, "A terabyte spills to DRAM");
+    
+    return 1;
+}
+
+int test_baseline_comparison() {
+    hc_bench_result_t results[2];
+    memset(results, 0, sizeof(results));
+    
+    results[0].op = HC_OP_MULTIPLY;
+    results[0].mode = HC_BENCH_LATENCY;
+    results[0].payload_bytes = 4096;
+    results[0].stats.average_latency_ns = 10.0;
+    results[0].stats.stddev_ns = 0.1;
+    results[0].stats.repetitions = 20;
+    results[1] = results[0];
+    results[1].op = HC_OP_ENCRYPT;
+    results[1].backend = "c";
+    
+    FILE* file = tmpfile();
+    TEST_ASSERT(file != NULL, "Temporary baseline file");
+    TEST_ASSERT(hc_bench_write_csv(file, results, 2) == HC_SUCCESS, "Baseline should be written");
+    rewind(file);
+    
+    hc_bench_baseline_t* baseline = NULL;
+    size_t baseline_count = 0;
+    TEST_ASSERT(hc_bench_read_baseline(file, &baseline, &baseline_count) == HC_SUCCESS, "Baseline should parse");
+    fclose(file);
+    TEST_ASSERT(baseline_count == 2, "Both rows read back");
+    TEST_ASSERT(strcmp(baseline[1].backend, "c") == 0, "Backend is part of the key");
+    
+    // Identical run: no regression
+    size_t regressions = 99;
+    hc_bench_compare(NULL, results, 2, baseline, baseline_count, 5.0, &regressions);
+    TEST_ASSERT(regressions == 0, "Unchanged results should not regress");
+    
+    // Multiply 20% slower with tight spread: significant regression
+    results[0].stats.average_latency_ns = 12.0;
+    // Encrypt 20% slower but too noisy to be significant
+    results[1].stats.average_latency_ns = 12.0;
+    results[1].stats.stddev_ns = 50.0;
+    hc_bench_compare(NULL, results, 2, baseline, baseline_count, 5.0, &regressions);
+    TEST_ASSERT(regressions == 1, "Only the significant slowdown regresses");
+    
+    // Below threshold
+    hc_bench_compare(NULL, results, 2, baseline, baseline_count, 25.0, &regressions);
+    TEST_ASSERT(regressions == 0, "Slowdowns under the threshold pass");
+    
+    free(baseline);
+    return 1;
+}
+
+int test_perf_counters() {
+    hc_perf_session_t session;
+    hc_hw_counters_t counters;
+    
+    TEST_ASSERT(hc_perf_open(NULL) == HC_ERROR_NULL_PTR, "Null session should be rejected");
+    
+    int ret = hc_perf_open(&session);
+    if (ret == HC_ERROR_UNSUPPORTED) {
+        // Counters are unavailable here (container, paranoid setting); the fallback is the test
+        printf("(counters unavailable) ");
+        TEST_ASSERT(hc_perf_stop(&session, &counters) == HC_ERROR_UNSUPPORTED, "Nothing to read");
+        TEST_ASSERT(counters.available == 0, "No counters should be marked available");
+        hc_perf_close(&session);
+        return 1;
+    }
+    TEST_ASSERT(ret == HC_SUCCESS, "Counters should open or report unsupported");
+    
+    quaternion_t q, r;
+    quaternion_init(&q, 1.0f, 2.0f, 3.0f, 4.0f);
+    hc_perf_start(&session);
+    for (int i = 0; i < 10000; i++) {
+        quaternion_normalize(&q, &r);
+    }
+    ret = hc_perf_stop(&session, &counters);
+    hc_perf_close(&session);
+    
+    TEST_ASSERT(ret == HC_SUCCESS, "Counters should be readable");
+    if (counters.available & (1u << HC_COUNTER_INSTRUCTIONS)) {
+        TEST_ASSERT(counters.values[HC_COUNTER_INSTRUCTIONS] >= 10000, "Instructions should be counted");
+    }
+    
+    return 1;
+}
+
+int test_backend_comparison() {
+    hc_backend_result_t results[HC_KERNEL_COUNT * HC_BACKEND_COUNT];
+    size_t count = 0;
+    hc_bench_config_t config;
+    
+    hc_bench_default_config(&config);
+    config.iterations = 4 * HC_BENCH_BATCH_COUNT;
+    config.repetitions = 3;
+    config.hw_counters = 0;
+    
+    TEST_ASSERT(hc_backend_available(HC_BACKEND_SCALAR), "Scalar backend should always exist");
+    TEST_ASSERT(hc_backend_available(HC_BACKEND_AUTOVEC), "Autovectorized backend should always exist");
+    TEST_ASSERT(!hc_backend_available(HC_BACKEND_COUNT), "Out-of-range backend should be unavailable");
+    
+    int ret = hc_bench_backends(&config, results, HC_KERNEL_COUNT * HC_BACKEND_COUNT, &count);
+    TEST_ASSERT(ret == HC_SUCCESS, "Backend comparison should run");
+    
+    size_t expected = 0;
+    for (int b = 0; b < HC_BACKEND_COUNT; b++) {
+        if (hc_backend_available((hc_backend_t)b)) expected += HC_KERNEL_COUNT;
+    }
+    TEST_ASSERT(count == expected, "Every available backend of every kernel should be measured");
+    
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT(results[i].max_error < 1e-4f, "Backends should agree with the scalar reference");
+        TEST_ASSERT(results[i].stats.average_latency_ns > 0.0, "Each backend should be timed");
+    }
+    
+    return 1;
+}
+
+int test_roofline() {
+    hc_kernel_cost_t cost;
+    hc_roofline_t roofline;
+    hc_bench_config_t config;
+    
+    TEST_ASSERT(hc_kernel_cost(HC_KERNEL_MULTIPLY, &cost) == HC_SUCCESS, "Multiply should have a cost");
+    TEST_ASSERT(cost.flops == 28.0 && cost.bytes == 48.0, "Multiply is 16 mul + 12 add over 48 bytes");
+    TEST_ASSERT(hc_kernel_cost(HC_KERNEL_COUNT, &cost) == HC_ERROR_INVALID_DATA, "Unknown kernel should fail");
+    
+    hc_bench_default_config(&config);
+    config.repetitions = 2;
+    config.hw_counters = 0;
+    
+    // A small working set keeps the test quick; the bound math doesn't depend on size
+    TEST_ASSERT(hc_bench_roofline(&config, 3 << 20, &roofline) == HC_SUCCESS, "Roofline should run");
+    TEST_ASSERT(roofline.peak_gflops > 0.0 && roofline.bandwidth_gbs > 0.0, "Host roofs should be measured");
+    TEST_ASSERT(roofline.count >= 2 * HC_KERNEL_COUNT, "Scalar and autovec should both be measured");
+    
+    for (size_t i = 0; i < roofline.count; i++) {
+        const hc_roofline_point_t* p = &roofline.points[i];
+        TEST_ASSERT(p->gflops > 0.0 && p->bound_gflops > 0.0, "Each kernel should be placed on the roofline");
+        TEST_ASSERT(p->bound_gflops <= roofline.peak_gflops * 1.0001, "Bound should never exceed the peak");
+    }
+    
+    FILE* csv = tmpfile();
+    TEST_ASSERT(csv != NULL, "Temporary file should open");
+    TEST_ASSERT(hc_bench_write_roofline_csv(csv, &roofline) == HC_SUCCESS, "CSV should be written");
+    
+    char line[256];
+    rewind(csv);
+    TEST_ASSERT(fgets(line, sizeof(line), csv) && strncmp(line, "kernel,backend,", 15) == 0,
+                "CSV should start with its header");
+    fclose(csv);
+    
+    return 1;
+}
+
+int test_accuracy_bounds() {
+    hc_accuracy_result_t results[HC_KERNEL_COUNT * HC_BACKEND_COUNT];
+    size_t count = 0;
+    
+    int ret = hc_accuracy_check(50000, 0xACC, results, HC_KERNEL_COUNT * HC_BACKEND_COUNT, &count);
+    if (ret != HC_SUCCESS) hc_accuracy_print(stdout, results, count);
+    TEST_ASSERT(ret == HC_SUCCESS, "Every backend should stay within its documented ULP bound");
+    TEST_ASSERT(count >= 2 * HC_KERNEL_COUNT, "Scalar and autovectorized backends should be checked");
+    
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT(results[i].samples > 35000, "Most inputs should be in each kernel's domain");
+        if (results[i].kernel == HC_KERNEL_CONJUGATE) {
+            TEST_ASSERT(results[i].max_ulp[1] == 0.0, "Conjugate should be exact");
+        }
+    }
+    
+    return 1;
+}
+
+// Flips between two tunings that differ in every field until told to stop
+static _Atomic int tuning_flipping;
+
+static void* tuning_flipper(void* arg) {
+    const hc_tuning_t* pair = (const hc_tuning_t*)arg;
+    
+    for (int i = 0; atomic_load(&tuning_flipping); i++) hc_tuning_set(&pair[i & 1]);
+    return NULL;
+}
+
+int test_tuning() {
+    hc_tuning_t saved, t, loaded;
+    enum { COUNT = 1000 };
+    static quaternion_t a[COUNT], b[COUNT], serial[COUNT], split[COUNT];
+    
+    hc_tuning_get(&saved);
+    hc_tuning_default(&t);
+    TEST_ASSERT(t.threads == 1 && t.batch_backend == HC_BACKEND_AUTOVEC, "Defaults keep calls inline");
+    
+    t.threads = 0;
+    TEST_ASSERT(hc_tuning_set(&t) == HC_ERROR_INVALID_DATA, "Zero threads should be rejected");
+    t.threads = 1;
+    t.batch_backend = HC_BACKEND_SCALAR;
+    TEST_ASSERT(hc_tuning_set(&t) == HC_ERROR_INVALID_DATA, "Scalar is not a batch backend");
+    
+    // Round-trip through a file of our own, so parallel runs don't collide
+    char path[] = "/tmp/hc_tuning_test_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Temporary tuning file");
+    close(fd);
+    hc_tuning_default(&t);
+    t.threads = 3;
+    t.chunk_elements = 64;
+    int save_status = hc_tuning_save(path, &t);
+    int load_status = hc_tuning_load(path);
+    remove(path);
+    TEST_ASSERT(save_status == HC_SUCCESS, "Tuning should save");
+    TEST_ASSERT(load_status == HC_SUCCESS, "Tuning should load");
+    hc_tuning_get(&loaded);
+    TEST_ASSERT(loaded.threads == 3 && loaded.chunk_elements == 64, "Loaded tuning should match");
+    TEST_ASSERT(hc_tuning_load("/nonexistent/hc.conf") == HC_ERROR_INVALID_DATA, "Missing file is reported");
+    
+    // Split across the pool, results must match the inline run
+    for (int i = 0; i < COUNT; i++) {
+        quaternion_init(&a[i], 1.0f + i, 0.5f, -0.25f * i, 2.0f);
+        quaternion_init(&b[i], 0.5f, 1.0f - i, 0.125f, -1.0f);
+    }
+    quaternion_init(&a[900], 0.0f, 0.0f, 0.0f, 0.0f);
+    
+    hc_tuning_default(&t);
+    hc_tuning_set(&t);
+    quaternion_multiply_batch(a, b, serial, COUNT);
+    hc_tuning_load(path);                     // Removed above; must not disturb the tuning
+    
+    t.threads = 4;
+    t.chunk_elements = 64;
+    hc_tuning_set(&t);
+    TEST_ASSERT(quaternion_multiply_batch(a, b, split, COUNT) == HC_SUCCESS, "Split multiply should succeed");
+    TEST_ASSERT(memcmp(serial, split, sizeof(serial)) == 0, "Split multiply should match inline");
+    TEST_ASSERT(quaternion_normalize_batch(a, split, COUNT) == HC_ERROR_DIVIDE_ZERO,
+                "A zero element in any chunk should be reported");
+    
+    // Readers racing a setter see one tuning or the other, never a mix
+    hc_tuning_t pair[2];
+    pthread_t flipper;
+    int torn = 0;
+    hc_tuning_default(&pair[0]);
+    pair[1] = pair[0];
+    pair[1].batch_backend = hc_backend_available(HC_BACKEND_SIMD) ? HC_BACKEND_SIMD : HC_BACKEND_AUTOVEC;
+    pair[1].chunk_elements = 64;
+    pair[1].threads = 4;
+    pair[1].nt_threshold_bytes = 1 << 20;
+    hc_tuning_set(&pair[0]);
+    atomic_store(&tuning_flipping, 1);
+    TEST_ASSERT(pthread_create(&flipper, NULL, tuning_flipper, pair) == 0, "Setter thread should start");
+    for (int i = 0; i < 100000; i++) {
+        hc_tuning_get(&t);
+        int first = t.chunk_elements == pair[0].chunk_elements;
+        const hc_tuning_t* expected = &pair[first ? 0 : 1];
+        torn |= t.batch_backend != expected->batch_backend || t.chunk_elements != expected->chunk_elements ||
+                t.threads != expected->threads || t.nt_threshold_bytes != expected->nt_threshold_bytes;
+    }
+    atomic_store(&tuning_flipping, 0);
+    pthread_join(flipper, NULL);
+    TEST_ASSERT(!torn, "A concurrent set should never be seen half-applied");
+    
+    hc_tuning_set(&saved);
+    return 1;
+}
+
+typedef struct {
+    hc_task_t task;
+    const uint8_t* message;
+    size_t length;
+    quaternion_t key;
+    uint8_t ciphertext[256];
+    size_t cipher_length;
+    int status;
+} async_encrypt_t;
+
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_cond = PTHREAD_COND_INITIALIZER;
+static int async_finished;
+
+static int async_encrypt_run(hc_task_t* task) {
+    async_encrypt_t* job = (async_encrypt_t*)task->context;
+    job->cipher_length = sizeof(job->ciphertext);
+    return hypercomplex_encrypt_data(job->message, job->length, &job->key, job->ciphertext, &job->cipher_length);
+}
+
+static void async_encrypt_done(hc_task_t* task, int status) {
+    async_encrypt_t* job = (async_encrypt_t*)task->context;
+    
+    pthread_mutex_lock(&async_lock);
+    job->status = status;
+    async_finished++;
+    pthread_cond_signal(&async_cond);
+    pthread_mutex_unlock(&async_lock);
+}
+
+int test_async_tasks() {
+    enum { JOBS = 8 };
+    static async_encrypt_t jobs[JOBS];
+    static const uint8_t message[100] = "queued on the worker pool";
+    
+    TEST_ASSERT(hc_task_submit(NULL) == HC_ERROR_NULL_PTR, "Null task should be rejected");
+    
+    async_finished = 0;
+    for (int i = 0; i < JOBS; i++) {
+        async_encrypt_t* job = &jobs[i];
+        job->task.run = async_encrypt_run;
+        job->task.done = async_encrypt_done;
+        job->task.context = job;
+        job->message = (i == JOBS - 1) ? NULL : message;
+        job->length = sizeof(message) - (size_t)i;
+        job->status = 1;
+        quaternion_generate_key(&job->key, 100 + (uint64_t)i);
+        TEST_ASSERT(hc_task_submit(&job->task) == HC_SUCCESS, "Task should be queued");
+    }
+    
+    pthread_mutex_lock(&async_lock);
+    while (async_finished < JOBS) pthread_cond_wait(&async_cond, &async_lock);
+    pthread_mutex_unlock(&async_lock);
+    
+    // Every task ran once and reported its own status
+    for (int i = 0; i < JOBS - 1; i++) {
+        uint8_t expected[256];
+        size_t expected_length = sizeof(expected);
+        hypercomplex_encrypt_data(message, jobs[i].length, &jobs[i].key, expected, &expected_length);
+        
+        TEST_ASSERT(jobs[i].status == HC_SUCCESS, "Queued encryption should succeed");
+        TEST_ASSERT(jobs[i].cipher_length == expected_length, "Queued cipher length should match");
+        TEST_ASSERT(memcmp(jobs[i].ciphertext + sizeof(hypercomplex_header_t), expected + sizeof(hypercomplex_header_t),
+                           expected_length - sizeof(hypercomplex_header_t)) == 0, "Queued ciphertext should match");
+    }
+    TEST_ASSERT(jobs[JOBS - 1].status == HC_ERROR_NULL_PTR, "A failing task should pass its error to done");
+    
+    return 1;
+}
+
+int test_streaming_stores() {
+    hc_tuning_t saved, t;
+    enum { COUNT = 515 };                // Odd length leaves a tail after the streamed pairs
+    static quaternion_t a[COUNT], b[COUNT], cached[COUNT + 1], streamed[COUNT + 1];
+    static uint8_t message[40000], cipher_cached[81000], cipher_streamed[81000];
+    
+    hc_tuning_get(&saved);
+    hc_tuning_default(&t);
+    if (hc_backend_available(HC_BACKEND_SIMD)) t.batch_backend = HC_BACKEND_SIMD;
+    
+    for (int i = 0; i < COUNT; i++) {
+        quaternion_init(&a[i], 1.0f + i, 0.5f * i, -0.25f, 2.0f);
+        quaternion_init(&b[i], 0.5f, 1.0f - i, 0.125f * i, -1.0f);
+    }
+    
+    // Same kernels with and without streaming stores, to aligned and misaligned outputs
+    for (int offset = 0; offset < 2; offset++) {
+        t.nt_threshold_bytes = 0;
+        hc_tuning_set(&t);
+        quaternion_multiply_batch(a, b, cached + offset, COUNT);
+        t.nt_threshold_bytes = sizeof(quaternion_t);
+        hc_tuning_set(&t);
+        TEST_ASSERT(quaternion_multiply_batch(a, b, streamed + offset, COUNT) == HC_SUCCESS,
+                    "Streamed multiply should succeed");
+        TEST_ASSERT(memcmp(cached + offset, streamed + offset, COUNT * sizeof(quaternion_t)) == 0,
+                    "Streamed multiply should match cached stores");
+        
+        TEST_ASSERT(quaternion_conjugate_batch(a, streamed + offset, COUNT) == HC_SUCCESS,
+                    "Streamed conjugate should succeed");
+        TEST_ASSERT_FLOAT_EQ(-a[COUNT - 1].z, streamed[offset + COUNT - 1].z, 0.0f, "Streamed conjugate tail");
+        
+        TEST_ASSERT(quaternion_normalize_batch(a, streamed + offset, COUNT) == HC_SUCCESS,
+                    "Streamed normalize should succeed");
+        TEST_ASSERT_FLOAT_EQ(1.0f, quaternion_norm(&streamed[offset + 7]), 1e-6f, "Streamed normalize");
+    }
+    
+    // Encryption past the threshold fuses the widening copy into the transform
+    quaternion_t key;
+    size_t len_cached = sizeof(cipher_cached), len_streamed = sizeof(cipher_streamed);
+    size_t length = sizeof(message) - 5;
+    for (size_t i = 0; i < sizeof(message); i++) message[i] = (uint8_t)(i * 7);
+    quaternion_generate_key(&key, 7);
+    
+    t.nt_threshold_bytes = 0;
+    hc_tuning_set(&t);
+    TEST_ASSERT(hypercomplex_encrypt_data(message, length, &key, cipher_cached, &len_cached) == HC_SUCCESS,
+                "Cached encryption should succeed");
+    t.nt_threshold_bytes = 4096;
+    hc_tuning_set(&t);
+    TEST_ASSERT(hypercomplex_encrypt_data(message, length, &key, cipher_streamed, &len_streamed) == HC_SUCCESS,
+                "Streamed encryption should succeed");
+    TEST_ASSERT(len_cached == len_streamed, "Cipher lengths should match");
+    
+    const float* fc = (const float*)(cipher_cached + sizeof(hypercomplex_header_t));
+    const float* fs = (const float*)(cipher_streamed + sizeof(hypercomplex_header_t));
+    for (size_t i = 0; i < (len_cached - sizeof(hypercomplex_header_t)) / sizeof(float); i++) {
+        TEST_ASSERT_FLOAT_EQ(fc[i], fs[i], 1e-3f * (1.0f + fabsf(fc[i])), "Streamed ciphertext should match");
+    }
+    
+    hc_tuning_set(&saved);
+    return 1;
+}
+
+int test_runtime_stats() {
+    hc_stats_t stats;
+    quaternion_t in[4], out[4];
+    
+    TEST_ASSERT(hc_stats_snapshot(NULL) == HC_ERROR_NULL_PTR, "Null snapshot should be rejected");
+    
+    if (hc_stats_enable(HC_STATS_COUNTERS) == HC_ERROR_UNSUPPORTED) {
+        // Built without -DHC_ENABLE_STATS; the hooks compile away and snapshots stay empty
+        printf("(stats compiled out) ");
+        TEST_ASSERT(hc_stats_snapshot(&stats) == HC_ERROR_UNSUPPORTED, "Snapshot should report unsupported");
+        TEST_ASSERT(stats.apis[HC_API_ADD_BATCH].calls == 0, "Counters should be zero");
+        return 1;
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        quaternion_init(&in[i], 1.0f, 0.0f, 0.0f, (float)i);
+    }
+    quaternion_init(&in[0], 0.0f, 0.0f, 0.0f, 0.0f);
+    
+    hc_stats_reset();
+    quaternion_add_batch(in, in, out, 4);
+    quaternion_add_batch(in, in, out, 4);
+    quaternion_normalize_batch(in, out, 4);     // Zero element reports DIVIDE_ZERO
+    quaternion_conjugate_batch(NULL, out, 4);
+    TEST_ASSERT(hc_stats_snapshot(&stats) == HC_SUCCESS, "Snapshot should succeed");
+    
+    TEST_ASSERT(stats.apis[HC_API_ADD_BATCH].calls == 2, "Add batch calls should be counted");
+    TEST_ASSERT(stats.apis[HC_API_ADD_BATCH].bytes == 2 * 2 * 4 * sizeof(quaternion_t), "Bytes should be counted");
+    TEST_ASSERT(stats.apis[HC_API_NORMALIZE_BATCH].errors[-HC_ERROR_DIVIDE_ZERO] == 1, "Errors should be keyed by code");
+    TEST_ASSERT(stats.apis[HC_API_CONJUGATE_BATCH].errors[-HC_ERROR_NULL_PTR] == 1, "Null input should be counted");
+    TEST_ASSERT(stats.apis[HC_API_MULTIPLY_BATCH].calls == 0, "Untouched APIs should stay zero");
+    
+    // Disabled at runtime: calls go uncounted
+    hc_stats_enable(0);
+    quaternion_add_batch(in, in, out, 4);
+    hc_stats_snapshot(&stats);
+    TEST_ASSERT(stats.apis[HC_API_ADD_BATCH].calls == 2, "Disabled stats should not count");
+    
+    hc_stats_reset();
+    hc_stats_snapshot(&stats);
+    TEST_ASSERT(stats.apis[HC_API_ADD_BATCH].calls == 0, "Reset should zero the counters");
+    
+    return 1;
+}
+
+int test_latency_histograms() {
+    hc_histogram_t hist;
+    
+    // Bucket math works regardless of build flags
+    memset(&hist, 0, sizeof(hist));
+    for (uint64_t ns = 1; ns <= 1000; ns++) {
+        hc_histogram_record(&hist, ns);
+    }
+    hc_histogram_record(&hist, 5000000);      // One page-fault sized outlier
+    
+    uint64_t p50 = hc_histogram_percentile(&hist, 50.0);
+    uint64_t p99 = hc_histogram_percentile(&hist, 99.0);
+    TEST_ASSERT(hist.count == 1001, "Every value should be counted");
+    TEST_ASSERT(p50 >= 500 && p50 <= 500 * 107 / 100, "Median should be within one bucket");
+    TEST_ASSERT(p99 >= 990 && p99 <= 990 * 107 / 100, "p99 should be within one bucket");
+    TEST_ASSERT(hc_histogram_max(&hist) >= 5000000, "Max should expose the outlier");
+    TEST_ASSERT(hc_histogram_percentile(&hist, 0.0) == 1, "Lowest values are exact");
+    TEST_ASSERT(hc_size_class(64) == HC_SIZE_CLASS_64 && hc_size_class(65) == HC_SIZE_CLASS_512,
+                "Size classes should split at their bounds");
+    
+    if (hc_stats_enable(HC_STATS_HISTOGRAMS) == HC_ERROR_UNSUPPORTED) {
+        printf("(stats compiled out) ");
+        TEST_ASSERT(hc_histogram_snapshot(HC_API_ENCRYPT_DATA, HC_SIZE_CLASS_4K, &hist) == HC_ERROR_UNSUPPORTED,
+                    "Snapshot should report unsupported");
+        TEST_ASSERT(hist.count == 0, "Histogram should be empty");
+        return 1;
+    }
+    
+    quaternion_t key;
+    uint8_t plaintext[1024], ciphertext[1024 + 256];
+    size_t cipher_len = sizeof(ciphertext);
+    memset(plaintext, 0xA5, sizeof(plaintext));
+    quaternion_generate_key(&key, 7);
+    
+    hc_stats_reset();
+    for (int i = 0; i < 10; i++) {
+        cipher_len = sizeof(ciphertext);
+        hypercomplex_encrypt_data(plaintext, sizeof(plaintext), &key, ciphertext, &cipher_len);
+    }
+    hc_stats_enable(0);
+    
+    TEST_ASSERT(hc_histogram_snapshot(HC_API_ENCRYPT_DATA, HC_SIZE_CLASS_4K, &hist) == HC_SUCCESS,
+                "Snapshot should succeed");
+    TEST_ASSERT(hist.count == 10, "Each encrypt call should be recorded");
+    TEST_ASSERT(hc_histogram_percentile(&hist, 99.0) > 0, "Latency should be non-zero");
+    
+    hc_histogram_snapshot(HC_API_ENCRYPT_DATA, HC_SIZE_CLASS_64, &hist);
+    TEST_ASSERT(hist.count == 0, "Other size classes should stay empty");
+    
+    hc_stats_reset();
+    hc_histogram_snapshot(HC_API_ENCRYPT_DATA, HC_SIZE_CLASS_4K, &hist);
+    TEST_ASSERT(hist.count == 0, "Reset should empty the histogram");
+    
+    return 1;
+}
+
+// Records alternating add and multiply calls, each size tied to its API, until told to stop
+static _Atomic int flight_writing;
+
+static void* flight_writer(void* arg) {
+    (void)arg;
+    quaternion_t a[32] = {{0}}, b[32] = {{0}}, out[32];
+    
+    while (atomic_load(&flight_writing)) {
+        quaternion_add_batch(a, b, out, 32);
+        quaternion_multiply_batch(a, b, out, 16);
+    }
+    return NULL;
+}
+
+int test_flight_recorder() {
+    hc_flight_entry_t entries[8];
+    size_t count = 0;
+    
+    if (hc_flight_enable(1) == HC_ERROR_UNSUPPORTED) {
+        printf("(stats compiled out) ");
+        TEST_ASSERT(hc_flight_snapshot(entries, 8, &count) == HC_ERROR_UNSUPPORTED,
+                    "Snapshot should report unsupported");
+        TEST_ASSERT(count == 0, "Snapshot should be empty");
+        return 1;
+    }
+    
+    quaternion_t a[64], b[64], out[64];
+    for (int i = 0; i < 64; i++) {
+        a[i] = (quaternion_t){i, 1.0f, 2.0f, 3.0f};
+        b[i] = (quaternion_t){1.0f, i, 0.5f, 0.25f};
+    }
+    
+    hc_flight_reset();
+    for (int i = 0; i < 3; i++) {
+        quaternion_add_batch(a, b, out, 64);
+    }
+    hc_flight_enable(0);
+    quaternion_add_batch(a, b, out, 64);     // Not recorded once disabled
+    
+    TEST_ASSERT(hc_flight_snapshot(entries, 8, &count) == HC_SUCCESS, "Snapshot should succeed");
+    TEST_ASSERT(count == 3, "Each call over the threshold should be recorded");
+    TEST_ASSERT(entries[0].api == HC_API_ADD_BATCH, "Entry should name the API");
+    TEST_ASSERT(entries[0].bytes == 2 * 64 * sizeof(quaternion_t), "Entry should carry the payload size");
+    TEST_ASSERT(entries[0].duration_ns >= 1, "Entry should carry the duration");
+    TEST_ASSERT(entries[0].timestamp_ns <= entries[2].timestamp_ns, "Entries should be oldest first");
+    
+    FILE* dump = tmpfile();
+    TEST_ASSERT(dump != NULL, "Temporary file should open");
+    TEST_ASSERT(hc_flight_dump(fileno(dump)) == HC_SUCCESS, "Dump should succeed");
+    
+    char text[4096];
+    rewind(dump);
+    size_t len = fread(text, 1, sizeof(text) - 1, dump);
+    text[len] = '\0';
+    fclose(dump);
+    TEST_ASSERT(strstr(text, "api=add_batch") != NULL, "Dump should list the recorded calls");
+    
+    // Snapshots taken while another thread overwrites its ring return whole entries
+    // only, and a reset mid-run leaves the writer's ring usable
+    pthread_t writer;
+    int torn = 0;
+    hc_flight_reset();
+    hc_flight_enable(1);
+    atomic_store(&flight_writing, 1);
+    TEST_ASSERT(pthread_create(&writer, NULL, flight_writer, NULL) == 0, "Writer thread should start");
+    for (int round = 0; round < 2000; round++) {
+        if (round == 1000) hc_flight_reset();
+        hc_flight_snapshot(entries, 8, &count);
+        for (size_t i = 0; i < count; i++) {
+            uint64_t bytes = entries[i].api == HC_API_ADD_BATCH ? 2 * 32 * sizeof(quaternion_t)
+                           : entries[i].api == HC_API_MULTIPLY_BATCH ? 2 * 16 * sizeof(quaternion_t) : 0;
+            torn |= entries[i].bytes != bytes || entries[i].status != HC_SUCCESS;
+        }
+    }
+    atomic_store(&flight_writing, 0);
+    pthread_join(writer, NULL);
+    hc_flight_enable(0);
+    TEST_ASSERT(!torn, "A concurrent snapshot should never return a half-written entry");
+    
+    // Only calls after a reset are listed, on a ring that was never rewound
+    hc_flight_reset();
+    hc_flight_enable(1);
+    quaternion_add_batch(a, b, out, 64);
+    quaternion_add_batch(a, b, out, 64);
+    hc_flight_enable(0);
+    TEST_ASSERT(hc_flight_snapshot(entries, 8, &count) == HC_SUCCESS && count == 2,
+                "Only calls recorded since the reset should be listed");
+    
+    hc_flight_reset();
+    TEST_ASSERT(hc_flight_snapshot(entries, 8, &count) == HC_SUCCESS && count == 0,
+                "Reset should clear every ring");
+    
+    return 1;
+}
+
+int test_prometheus_export() {
+    quaternion_t a[16], b[16], out[16];
+    for (int i = 0; i < 16; i++) {
+        a[i] = (quaternion_t){1.0f, 0.0f, 0.0f, 0.0f};
+        b[i] = (quaternion_t){0.0f, 1.0f, 0.0f, 0.0f};
+    }
+    
+    int stats = hc_stats_enable(HC_STATS_COUNTERS | HC_STATS_HISTOGRAMS) == HC_SUCCESS;
+    hc_stats_reset();
+    for (int i = 0; i < 3; i++) {
+        quaternion_add_batch(a, b, out, 16);
+    }
+    quaternion_add_batch(NULL, b, out, 16);
+    hc_stats_enable(0);
+    
+    size_t length = hc_stats_format_prometheus(NULL, 0);
+    char* text = malloc(length + 1);
+    TEST_ASSERT(text != NULL, "Allocation should succeed");
+    TEST_ASSERT(hc_stats_format_prometheus(text, length + 1) == length, "Sizing pass should match");
+    TEST_ASSERT(strstr(text, "hypercomplex_backend_info{backend=") != NULL, "Backend should be exported");
+    if (stats) {
+        TEST_ASSERT(strstr(text, "hypercomplex_calls_total{api=\"add_batch\"} 4\n") != NULL,
+                    "Calls should be exported");
+        TEST_ASSERT(strstr(text, "hypercomplex_errors_total{api=\"add_batch\",code=\"null_ptr\"} 1\n") != NULL,
+                    "Errors should be exported by code");
+        TEST_ASSERT(strstr(text, "hypercomplex_latency_seconds_count{api=\"add_batch\",size=\"<=512B\"} 4\n") != NULL,
+                    "Histogram should be exported per size class");
+    } else {
+        printf("(stats compiled out) ");
+    }
+    free(text);
+    
+    // One scrape over a Unix socket
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/hc_exporter_test_%d.sock", (int)getpid());
+    TEST_ASSERT(hc_exporter_start_unix(path) == HC_SUCCESS, "Exporter should start");
+    TEST_ASSERT(hc_exporter_start_unix(path) != HC_SUCCESS, "Only one exporter should run");
+    
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    int connected = fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+    
+    char response[8192];
+    size_t received = 0;
+    if (connected) {
+        const char* request = "GET /metrics HTTP/1.0\r\n\r\n";
+        ssize_t n = write(fd, request, strlen(request));
+        while (n > 0 && received < sizeof(response) - 1) {
+            n = read(fd, response + received, sizeof(response) - 1 - received);
+            if (n > 0) received += (size_t)n;
+        }
+    }
+    response[received] = '\0';
+    if (fd >= 0) close(fd);
+    hc_exporter_stop();
+    
+    TEST_ASSERT(connected, "Exporter socket should accept connections");
+    TEST_ASSERT(strncmp(response, "HTTP/1.0 200 OK", 15) == 0, "Scrape should succeed");
+    TEST_ASSERT(strstr(response, "hypercomplex_threads") != NULL, "Scrape should carry the metrics");
+    TEST_ASSERT(access(path, F_OK) != 0, "Stop should remove the socket");
+    
+    return 1;
+}
+
 /*
  * Integration Tests
  */
@@ -323,6 +1426,300 @@ int test_quaternion_properties() {
     return 1;
 }
 
+/*
+ * Benchmark runner
+ */
+
+typedef struct {
+    size_t iterations;          // Operations per benchmark row, split across repetitions
+    size_t repetitions;
+    int cpu;
+    const char* json_path;
+    const char* csv_path;
+    const char* save_baseline_path;
+    const char* baseline_path;
+    double threshold_pct;       // Slowdown that counts as a regression
+} bench_options_t;
+
+#define EXIT_REGRESSION 2
+
+int write_bench_report(const char* path, const hc_bench_result_t* results, size_t count,
+                       int (*writer)(FILE*, const hc_bench_result_t*, size_t)) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out) {
+        printf("Cannot open %s for writing\n", path);
+        return EXIT_FAILURE;
+    }
+    
+    int ret = writer(out, results, count);
+    if (out != stdout) fclose(out);
+    return ret == HC_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int compare_with_baseline(const bench_options_t* options,
+                          const hc_bench_result_t* results, size_t count) {
+    FILE* in = fopen(options->baseline_path, "r");
+    if (!in) {
+        printf("Cannot open baseline %s\n", options->baseline_path);
+        return EXIT_FAILURE;
+    }
+    
+    hc_bench_baseline_t* baseline = NULL;
+    size_t baseline_count = 0;
+    int ret = hc_bench_read_baseline(in, &baseline, &baseline_count);
+    fclose(in);
+    if (ret != HC_SUCCESS) {
+        printf("Cannot parse baseline %s\n", options->baseline_path);
+        return EXIT_FAILURE;
+    }
+    
+    size_t regressions = 0;
+    printf("Comparison against %s (threshold %.1f%%):\n", options->baseline_path, options->threshold_pct);
+    hc_bench_compare(stdout, results, count, baseline, baseline_count, options->threshold_pct, &regressions);
+    free(baseline);
+    
+    printf("%zu regression(s)\n", regressions);
+    return regressions ? EXIT_REGRESSION : EXIT_SUCCESS;
+}
+
+// Writes the requested reports, then gates on the baseline if one was given
+int finish_bench_run(const bench_options_t* options, const hc_bench_result_t* results, size_t count) {
+    if (options->json_path &&
+        write_bench_report(options->json_path, results, count, hc_bench_write_json) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    if (options->csv_path &&
+        write_bench_report(options->csv_path, results, count, hc_bench_write_csv) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    if (options->save_baseline_path &&
+        write_bench_report(options->save_baseline_path, results, count, hc_bench_write_csv) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    
+    return options->baseline_path ? compare_with_baseline(options, results, count) : EXIT_SUCCESS;
+}
+
+int run_benchmark_suite(const bench_options_t* options) {
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.repetitions = options->repetitions;
+    config.cpu = options->cpu;
+    
+    hc_bench_result_t results[HC_OP_COUNT * 2];
+    size_t count = 0;
+    
+    printf("Running performance benchmark...\n");
+    printf("Performance Results (core clock ~%.2f GHz, %zu-byte messages, %zu repetitions):\n",
+           hc_bench_cpu_ghz(), config.payload_bytes, config.repetitions);
+    printf("  %-14s %-11s %10s %10s %10s %10s %10s %6s %10s\n",
+           "Operation", "Mode", "ns/op", "+/-95%", "median", "p99", "cycles/op", "IPC", "MB/s");
+    
+    for (int op = 0; op < HC_OP_COUNT; op++) {
+        // Scale bulk operations down so each one processes about the same bytes
+        int bulk = (op == HC_OP_ENCRYPT || op == HC_OP_ENCRYPT_DATA || op == HC_OP_DECRYPT_DATA);
+        int batch = (op >= HC_OP_MULTIPLY_BATCH);
+        size_t total = bulk ? options->iterations / (config.payload_bytes / sizeof(quaternion_t))
+                     : batch ? options->iterations / HC_BENCH_BATCH_COUNT
+                     : options->iterations;
+        config.iterations = total / config.repetitions;
+        if (config.iterations == 0) config.iterations = 1;
+        config.warmup = total / 10;
+        
+        for (int mode = HC_BENCH_LATENCY; mode <= HC_BENCH_THROUGHPUT; mode++) {
+            hc_bench_result_t* r = &results[count++];
+            r->op = (hc_op_t)op;
+            r->mode = (hc_bench_mode_t)mode;
+            r->payload_bytes = config.payload_bytes;
+            r->backend = NULL;
+            
+            if (hc_bench_run(r->op, r->mode, &config, &r->stats) != HC_SUCCESS) {
+                printf("  %-14s %-11s failed\n", hc_op_name(r->op), hc_bench_mode_name(r->mode));
+                return EXIT_FAILURE;
+            }
+            
+            const perf_stats_t* st = &r->stats;
+            double seconds = st->average_latency_ns * config.iterations * config.repetitions / 1e9;
+            char ipc[16] = "-";
+            uint32_t needed = (1u << HC_COUNTER_CYCLES) | (1u << HC_COUNTER_INSTRUCTIONS);
+            if ((st->hw.available & needed) == needed && st->hw.values[HC_COUNTER_CYCLES] > 0) {
+                snprintf(ipc, sizeof(ipc), "%.2f", (double)st->hw.values[HC_COUNTER_INSTRUCTIONS] /
+                                                   (double)st->hw.values[HC_COUNTER_CYCLES]);
+            }
+            printf("  %-14s %-11s %10.2f %10.2f %10.2f %10.2f %10.2f %6s %10.2f\n",
+                   hc_op_name(r->op), hc_bench_mode_name(r->mode),
+                   st->average_latency_ns, st->ci95_ns, st->median_ns, st->p99_ns,
+                   st->cycles_per_op, ipc, st->bytes_processed / 1024.0 / 1024.0 / seconds);
+        }
+    }
+    
+    return finish_bench_run(options, results, count);
+}
+
+int run_working_set_sweep(const bench_options_t* options, size_t max_bytes) {
+    static const hc_op_t kernels[] = {
+        HC_OP_MULTIPLY_BATCH, HC_OP_ADD_BATCH, HC_OP_CONJUGATE_BATCH, HC_OP_NORMALIZE_BATCH, HC_OP_ENCRYPT
+    };
+    static const char* const levels[] = { "", "L1", "L2", "LLC", "DRAM" };
+    enum { KERNELS = sizeof(kernels) / sizeof(kernels[0]), POINTS = 64 };
+    
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.repetitions = options->repetitions;
+    config.cpu = options->cpu;
+    
+    hc_bench_result_t results[KERNELS * POINTS];
+    size_t total = 0;
+    
+    hc_tuning_t tuning;
+    hc_tuning_get(&tuning);
+    printf("Working-set sweep (L1 %zu KB, L2 %zu KB, LLC %zu KB, huge pages %s, nt threshold %zu KB):\n",
+           hc_cache_size(1) >> 10, hc_cache_size(2) >> 10, hc_cache_size(3) >> 10,
+           hc_huge_pages_name(hc_huge_pages_get()), tuning.nt_threshold_bytes >> 10);
+    printf("  %-16s %12s %6s %10s %10s %10s %10s %10s\n",
+           "Kernel", "Working set", "Level", "ns/elem", "cyc/elem", "bytes/cyc", "GB/s", "dTLB/1k");
+    
+    for (int k = 0; k < KERNELS; k++) {
+        size_t count = 0;
+        if (hc_bench_sweep(kernels[k], &config, 4096, max_bytes,
+                           &results[total], POINTS, &count) != HC_SUCCESS) {
+            printf("  %-16s failed\n", hc_op_name(kernels[k]));
+            return EXIT_FAILURE;
+        }
+        
+        for (size_t i = total; i < total + count; i++) {
+            const perf_stats_t* st = &results[i].stats;
+            double cycles = st->cycles_per_op * (double)st->operations;
+            double seconds = st->average_latency_ns * (double)st->operations / 1e9;
+            char dtlb[16] = "-";
+            if ((st->hw.available & (1u << HC_COUNTER_DTLB_MISSES)) && st->operations > 0) {
+                snprintf(dtlb, sizeof(dtlb), "%.3f", 1000.0 * (double)st->hw.values[HC_COUNTER_DTLB_MISSES] /
+                                                     (double)st->operations);
+            }
+            printf("  %-16s %9zu KB %6s %10.3f %10.3f %10.2f %10.2f %10s\n",
+                   hc_op_name(results[i].op), results[i].payload_bytes >> 10,
+                   levels[hc_cache_level(results[i].payload_bytes)],
+                   st->average_latency_ns, st->cycles_per_op,
+                   cycles > 0.0 ? st->bytes_processed / cycles : 0.0,
+                   st->bytes_processed / seconds / 1e9, dtlb);
+        }
+        total += count;
+    }
+    
+    return finish_bench_run(options, results, total);
+}
+
+int run_backend_comparison(const bench_options_t* options) {
+    hc_backend_result_t results[HC_KERNEL_COUNT * HC_BACKEND_COUNT];
+    size_t count = 0;
+    
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.iterations = options->iterations / options->repetitions;
+    config.repetitions = options->repetitions;
+    config.cpu = options->cpu;
+    
+    printf("Backend comparison (%d quaternions per pass, core clock ~%.2f GHz):\n",
+           HC_BENCH_BATCH_COUNT, hc_bench_cpu_ghz());
+    if (hc_bench_backends(&config, results, HC_KERNEL_COUNT * HC_BACKEND_COUNT, &count) != HC_SUCCESS) {
+        printf("  failed\n");
+        return EXIT_FAILURE;
+    }
+    hc_bench_print_backends(stdout, results, count);
+    
+    // Fused and unfused arithmetic differ in the last bits only
+    for (size_t i = 0; i < count; i++) {
+        if (!(results[i].max_error < 1e-4f)) {
+            printf("%s/%s disagrees with the scalar backend\n",
+                   hc_kernel_name(results[i].kernel), hc_backend_name(results[i].backend));
+            return EXIT_FAILURE;
+        }
+    }
+    
+    return EXIT_SUCCESS;
+}
+
+int run_roofline(const bench_options_t* options) {
+    hc_roofline_t roofline;
+    hc_bench_config_t config;
+    
+    hc_bench_default_config(&config);
+    config.repetitions = options->repetitions;
+    config.cpu = options->cpu;
+    
+    printf("Roofline (single core):\n");
+    if (hc_bench_roofline(&config, options->iterations, &roofline) != HC_SUCCESS) {
+        printf("  failed\n");
+        return EXIT_FAILURE;
+    }
+    hc_bench_print_roofline(stdout, &roofline);
+    
+    if (options->csv_path) {
+        FILE* f = fopen(options->csv_path, "w");
+        if (!f || hc_bench_write_roofline_csv(f, &roofline) != HC_SUCCESS) {
+            printf("Could not write %s\n", options->csv_path);
+            if (f) fclose(f);
+            return EXIT_FAILURE;
+        }
+        fclose(f);
+    }
+    
+    return EXIT_SUCCESS;
+}
+
+int run_accuracy_check(const bench_options_t* options) {
+    hc_accuracy_result_t results[HC_KERNEL_COUNT * HC_BACKEND_COUNT];
+    size_t count = 0;
+    
+    printf("Accuracy against a long double reference (%zu inputs per kernel):\n", options->iterations);
+    int ret = hc_accuracy_check(options->iterations, 0x5EED, results,
+                                HC_KERNEL_COUNT * HC_BACKEND_COUNT, &count);
+    hc_accuracy_print(stdout, results, count);
+    
+    if (ret != HC_SUCCESS) {
+        printf("Documented accuracy bounds exceeded\n");
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
+
+int run_autotune(const bench_options_t* options, const char* path) {
+    hc_bench_config_t config;
+    hc_tuning_t best;
+    char default_path[512];
+    
+    hc_bench_default_config(&config);
+    config.repetitions = options->repetitions;
+    config.cpu = options->cpu;
+    
+    if (!path) {
+        if (hc_tuning_path(default_path, sizeof(default_path)) != HC_SUCCESS) {
+            printf("No tuning file path; set HC_TUNING_FILE or HOME\n");
+            return EXIT_FAILURE;
+        }
+        path = default_path;
+    }
+    
+    printf("Autotuning batch kernels and encryption...\n");
+    if (hc_autotune(&config, &best) != HC_SUCCESS) {
+        printf("  failed\n");
+        return EXIT_FAILURE;
+    }
+    
+    printf("  batch_backend  %s\n", hc_backend_name(best.batch_backend));
+    printf("  threads        %u\n", best.threads);
+    printf("  chunk_elements %zu\n", best.chunk_elements);
+    
+    if (hc_tuning_save(path, &best) != HC_SUCCESS) {
+        printf("Could not write %s\n", path);
+        return EXIT_FAILURE;
+    }
+    printf("Saved to %s\n", path);
+    
+    return EXIT_SUCCESS;
+}
+
 /*
  * Main test runner
  */
@@ -344,16 +1741,68 @@ int main(int argc, char* argv[]) {
     printf("WARNING: This code is optimized for ARM64 architecture\n");
 #endif
     
-    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
-        perf_stats_t stats;
-        printf("Running performance benchmark...\n");
-        if (hypercomplex_benchmark(10000000, &stats) == HC_SUCCESS) {
-            printf("Performance Results:\n");
-            printf("  Operations/sec: %lu\n", stats.operations_per_second);
-            printf("  Average latency: %.2f ns\n", stats.average_latency_ns);
-            printf("  Bytes processed: %zu\n", stats.bytes_processed);
+    if (argc > 1 && strcmp(argv[1], "--autotune") == 0) {
+        // --autotune [tuning file]
+        bench_options_t options = { 0, 5, HC_BENCH_CPU_CURRENT, NULL, NULL, NULL, NULL, 5.0 };
+        return run_autotune(&options, argc > 2 ? argv[2] : NULL);
+    }
+    
+    if (argc > 1 && (strcmp(argv[1], "--benchmark") == 0 || strcmp(argv[1], "--sweep") == 0 ||
+                     strcmp(argv[1], "--backends") == 0 || strcmp(argv[1], "--accuracy") == 0 ||
+                     strcmp(argv[1], "--roofline") == 0)) {
+        int sweep = strcmp(argv[1], "--sweep") == 0;
+        int backends = strcmp(argv[1], "--backends") == 0;
+        int accuracy = strcmp(argv[1], "--accuracy") == 0;
+        int roofline = strcmp(argv[1], "--roofline") == 0;
+        bench_options_t options = { sweep ? (size_t)4 << 30 : accuracy ? 4000000 : roofline ? 0 : 10000000,
+                                    sweep || roofline ? 5 : 20, HC_BENCH_CPU_CURRENT, NULL, NULL, NULL, NULL, 5.0 };
+        
+        // --benchmark [iterations] [--repetitions N] [--cpu N] [--json FILE] [--csv FILE]
+        //             [--save-baseline FILE] [--baseline FILE] [--threshold PERCENT]
+        // --sweep [max working-set bytes] [--huge-pages off|thp|hugetlb] [--nt-threshold BYTES] [same options]
+        // --backends [quaternions per kernel] [--repetitions N] [--cpu N]
+        // --accuracy [inputs per kernel]
+        // --roofline [working-set bytes] [--repetitions N] [--cpu N] [--csv FILE]
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+                options.repetitions = strtoull(argv[++i], NULL, 10);
+            } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+                options.cpu = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+                options.json_path = argv[++i];
+            } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+                options.csv_path = argv[++i];
+            } else if (strcmp(argv[i], "--save-baseline") == 0 && i + 1 < argc) {
+                options.save_baseline_path = argv[++i];
+            } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+                options.baseline_path = argv[++i];
+            } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+                options.threshold_pct = strtod(argv[++i], NULL);
+            } else if (strcmp(argv[i], "--huge-pages") == 0 && i + 1 < argc) {
+                const char* mode = argv[++i];
+                hc_huge_pages_t huge = strcmp(mode, "thp") == 0 ? HC_HUGE_PAGES_THP
+                                     : strcmp(mode, "hugetlb") == 0 ? HC_HUGE_PAGES_HUGETLB
+                                     : HC_HUGE_PAGES_OFF;
+                if (hc_huge_pages_set(huge) != HC_SUCCESS) {
+                    fprintf(stderr, "Huge pages (%s) not supported on this platform\n", mode);
+                    return EXIT_FAILURE;
+                }
+            } else if (strcmp(argv[i], "--nt-threshold") == 0 && i + 1 < argc) {
+                hc_tuning_t tuning;
+                hc_tuning_get(&tuning);
+                tuning.nt_threshold_bytes = strtoull(argv[++i], NULL, 10);
+                hc_tuning_set(&tuning);
+            } else {
+                options.iterations = strtoull(argv[i], NULL, 10);
+            }
         }
-        return 0;
+        
+        if (options.repetitions == 0) options.repetitions = 1;
+        if (backends) return run_backend_comparison(&options);
+        if (accuracy) return run_accuracy_check(&options);
+        if (roofline) return run_roofline(&options);
+        return sweep ? run_working_set_sweep(&options, options.iterations)
+                     : run_benchmark_suite(&options);
     }
     
     // Run all tests
@@ -364,10 +1813,32 @@ int main(int argc, char* argv[]) {
     RUN_TEST(test_quaternion_norm);
     RUN_TEST(test_quaternion_normalize);
     RUN_TEST(test_null_pointer_handling);
+    RUN_TEST(test_batch_operations);
+    RUN_TEST(test_aligned_batch);
+    RUN_TEST(test_reductions);
+    RUN_TEST(test_unit_quaternions);
     RUN_TEST(test_encryption_decryption);
+    RUN_TEST(test_decrypt_exact);
+    RUN_TEST(test_buffer_pool);
+    RUN_TEST(test_huge_pages);
     RUN_TEST(test_edge_cases);
     RUN_TEST(test_quaternion_properties);
     RUN_TEST(test_performance);
+    RUN_TEST(test_benchmark_suite);
+    RUN_TEST(test_benchmark_statistics);
+    RUN_TEST(test_working_set_sweep);
+    RUN_TEST(test_baseline_comparison);
+    RUN_TEST(test_perf_counters);
+    RUN_TEST(test_backend_comparison);
+    RUN_TEST(test_roofline);
+    RUN_TEST(test_accuracy_bounds);
+    RUN_TEST(test_tuning);
+    RUN_TEST(test_streaming_stores);
+    RUN_TEST(test_async_tasks);
+    RUN_TEST(test_runtime_stats);
+    RUN_TEST(test_latency_histograms);
+    RUN_TEST(test_flight_recorder);
+    RUN_TEST(test_prometheus_export);
     
     print_test_summary();
     
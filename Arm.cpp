@@ -0,0 +1,594 @@
+/*
+ * test_hypercomplex_cxx.cpp - Runtime tests for the C++ section of the header
+ * Built as C++20 against the same library objects as the C suite
+ */
+
+#include "hypercomplex.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <array>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Test framework macros, as in the C suite
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL: %s - %s\n", __func__, message); \
+            return 0; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("Running %s... ", #test_func); \
+        if (test_func()) { \
+            printf("PASS\n"); \
+            passed_tests++; \
+        } else { \
+            failed_tests++; \
+        } \
+        total_tests++; \
+    } while(0)
+
+// Global test counters
+static int total_tests = 0;
+static int passed_tests = 0;
+static int failed_tests = 0;
+
+static bool near(const hc::quaternionf& expected, const hc::quaternionf& actual, float tolerance) {
+    return std::fabs(expected.w - actual.w) <= tolerance && std::fabs(expected.x - actual.x) <= tolerance &&
+           std::fabs(expected.y - actual.y) <= tolerance && std::fabs(expected.z - actual.z) <= tolerance;
+}
+
+/*
+ * Fixed-size kernels: every length from 1 to 17 crosses each step width's
+ * remainders (8, 4 and single elements); 63-66 and 80 cross the unroll limit
+ * into the batch kernels
+ */
+
+template <typename T>
+static bool near(const hc::quaternion<T>& expected, const hc::quaternion<T>& actual) {
+    T tolerance = T(1e-5) * (T(1) + hc::norm(expected));
+    return std::fabs(expected.w - actual.w) <= tolerance && std::fabs(expected.x - actual.x) <= tolerance &&
+           std::fabs(expected.y - actual.y) <= tolerance && std::fabs(expected.z - actual.z) <= tolerance;
+}
+
+template <typename T, size_t N>
+static bool check_fixed() {
+    std::array<hc::quaternion<T>, N> a, b;
+    
+    for (size_t i = 0; i < N; i++) {
+        T f = static_cast<T>(i);
+        a[i] = hc::quaternion<T>(T(1) + f, T(0.5) * f, T(-0.25) * f, T(2));
+        b[i] = hc::quaternion<T>(T(0.5), T(1) - f, T(0.125) * f, T(-1));
+    }
+    if (N > 2) a[N / 2] = hc::quaternion<T>();      // Passes through normalize unchanged
+    
+    auto product = hc::multiply(a, b);
+    auto sum = hc::add(a, b);
+    auto conj = hc::conjugate(a);
+    auto unit = hc::normalize(a);
+    for (size_t i = 0; i < N; i++) {
+        if (!near(a[i] * b[i], product[i]) || !near(a[i] + b[i], sum[i]) ||
+            !near(hc::conjugate(a[i]), conj[i]) || !near(hc::normalized(a[i]), unit[i])) {
+            printf("mismatch at N = %zu, element %zu: ", N, i);
+            return false;
+        }
+    }
+    
+#ifdef HC_HAVE_SPAN
+    // Spans write in place; each result must match the array overloads
+    std::array<hc::quaternion<T>, N> out = a;
+    hc::multiply(std::span<const hc::quaternion<T>, N>(a), std::span{ b }, std::span{ out });
+    if (out != product) return false;
+    out = a;
+    hc::add(std::span{ out }, std::span{ b }, std::span{ out });
+    if (out != sum) return false;
+    out = a;
+    hc::conjugate(std::span{ out }, std::span{ out });
+    if (out != conj) return false;
+    out = a;
+    hc::normalize(std::span{ out }, std::span{ out });
+    if (out != unit) return false;
+#endif
+    
+    return true;
+}
+
+template <typename T, size_t... N>
+static bool check_fixed_lengths(std::index_sequence<N...>) {
+    return (check_fixed<T, N + 1>() && ...);
+}
+
+int test_fixed_size_kernels() {
+    TEST_ASSERT(check_fixed_lengths<float>(std::make_index_sequence<17>{}), "Float arrays of 1-17 match the scalar operators");
+    TEST_ASSERT((check_fixed<float, 63>() && check_fixed<float, 64>() && check_fixed<float, 65>() &&
+                 check_fixed<float, 66>() && check_fixed<float, 80>()), "Float arrays around the unroll limit match");
+    TEST_ASSERT(check_fixed_lengths<double>(std::make_index_sequence<9>{}), "Double arrays match the scalar operators");
+    TEST_ASSERT((check_fixed<double, 64>() && check_fixed<double, 65>()), "Double arrays past the unroll limit match");
+    
+    return 1;
+}
+
+int test_unit_from() {
+    auto huge = hc::unit_quaternionf::from(hc::quaternionf(1e20f, 1e20f, 0.0f, 0.0f));
+    TEST_ASSERT(huge.has_value(), "A huge finite input has a unit quaternion");
+    TEST_ASSERT(near(hc::quaternionf(std::sqrt(0.5f), std::sqrt(0.5f), 0.0f, 0.0f), huge->value(), 1e-6f),
+                "A huge finite input keeps its direction");
+    TEST_ASSERT(!hc::unit_quaternionf::from(hc::quaternionf(INFINITY, 1.0f, 0.0f, 0.0f)), "Inf is rejected");
+    TEST_ASSERT(!hc::unit_quaternionf::from(hc::quaternionf(NAN, 1.0f, 0.0f, 0.0f)), "NaN is rejected");
+    TEST_ASSERT(!hc::unit_quaternionf::from(hc::quaternionf()), "Zero is rejected");
+    
+    return 1;
+}
+
+/*
+ * Expression templates: evaluate must match the scalar operators element by
+ * element. 2500 elements cross two of evaluate's 1024-element normalize blocks
+ * and leave a tail.
+ */
+
+int test_expression_templates() {
+    const size_t n = 2500;
+    std::vector<hc::quaternionf> a(n), b(n), c(n), out(n), expected(n);
+    const hc::quaternionf key(0.5f, -0.5f, 0.5f, 0.5f);
+    
+    for (size_t i = 0; i < n; i++) {
+        float f = static_cast<float>(i % 97);
+        a[i] = hc::quaternionf(1.0f + f, 0.5f * f, -0.25f * f, 2.0f);
+        b[i] = hc::quaternionf(0.5f, 1.0f - f, 0.125f * f, -1.0f);
+        c[i] = hc::quaternionf(-f, 0.25f, 3.0f, 0.5f * f);
+    }
+    a[1500] = c[1500] = hc::quaternionf();          // a * b + c is zero: passes through normalize unchanged
+    
+    auto va = hc::view(a.data(), n), vb = hc::view(b.data(), n), vc = hc::view(c.data(), n);
+    for (size_t i = 0; i < n; i++) expected[i] = hc::normalized(a[i] * b[i] + c[i]);
+    TEST_ASSERT(hc::evaluate(out.data(), n, hc::normalize(va * vb + vc)) == HC_SUCCESS, "normalize(a * b + c) should evaluate");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(expected[i], out[i]), "normalize(a * b + c) should match the scalar operators");
+    }
+    TEST_ASSERT(out[1500] == hc::quaternionf(), "A zero element should pass through normalize");
+    
+    // Scale, broadcast and conjugate
+    TEST_ASSERT(hc::evaluate(out.data(), n, 0.5f * hc::conjugate(va) * hc::broadcast(key) - vc * 2.0f) == HC_SUCCESS,
+                "Scaled, broadcast and conjugated terms should evaluate");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(hc::conjugate(a[i]) * 0.5f * key - c[i] * 2.0f, out[i]), "Mixed terms should match the scalar operators");
+    }
+    
+    // Double trees take the element loop, normalize included
+    std::vector<hc::quaterniond> d(n), dout(n);
+    for (size_t i = 0; i < n; i++) d[i] = hc::quaterniond(a[i].w, a[i].x, a[i].y, a[i].z);
+    auto vd = hc::view(d.data(), n);
+    TEST_ASSERT(hc::evaluate(dout.data(), n, hc::normalize(-vd + vd * vd)) == HC_SUCCESS, "Double expression should evaluate");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(hc::normalized(-d[i] + d[i] * d[i]), dout[i]), "Double expression should match the scalar operators");
+    }
+    
+    // Operands of different lengths, and a null output
+    TEST_ASSERT(hc::evaluate(out.data(), n, va + hc::view(b.data(), n - 1)) == HC_ERROR_INVALID_DATA,
+                "A shorter operand should be rejected");
+    TEST_ASSERT(hc::evaluate(out.data(), n, hc::normalize(va * hc::view(b.data(), n + 1))) == HC_ERROR_INVALID_DATA,
+                "A longer operand under normalize should be rejected");
+    TEST_ASSERT(hc::evaluate(static_cast<hc::quaternionf*>(nullptr), n, va + vb) == HC_ERROR_NULL_PTR,
+                "A null output should be rejected");
+    
+    // out aliasing an operand, on both paths
+    std::vector<hc::quaternionf> x = a;
+    auto vx = hc::view(x.data(), n);
+    TEST_ASSERT(hc::evaluate(x.data(), n, hc::normalize(vx * vb + vc)) == HC_SUCCESS, "In-place normalize should evaluate");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(expected[i], x[i]), "In-place normalize(a * b + c) should match");
+    }
+    x = a;
+    TEST_ASSERT(hc::evaluate(x.data(), n, vx * vb + vx) == HC_SUCCESS, "In-place expression should evaluate");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(a[i] * b[i] + a[i], x[i]), "In-place a * b + a should match");
+    }
+    
+    return 1;
+}
+
+#ifdef HC_HAVE_PMR
+
+/*
+ * Frame arenas and pmr containers: a counting upstream resource shows when
+ * the arena goes back to it
+ */
+
+struct counting_resource : std::pmr::memory_resource {
+    size_t allocations = 0;
+    size_t outstanding = 0;
+    
+    void* do_allocate(size_t bytes, size_t align) override {
+        allocations++;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+static bool aligned64(const void* p) {
+    return (reinterpret_cast<std::uintptr_t>(p) & 63) == 0;
+}
+
+// One frame's worth of containers, enough to spill past a 4 KB first chunk
+static bool arena_frame(hc::arena_resource& arena) {
+    hc::quat_vector<float> v(&arena);
+    hc::quat_soa_vector<float> soa(&arena);
+    
+    for (int i = 0; i < 300; i++) {
+        v.push_back(hc::quaternionf(static_cast<float>(i), 0.0f, 0.0f, 1.0f));
+        soa.push_back(v.back());
+    }
+    return aligned64(v.data()) && aligned64(soa.w()) && aligned64(soa.x()) && aligned64(soa.y()) && aligned64(soa.z());
+}
+
+int test_arena_resource() {
+    counting_resource upstream;
+    
+    {
+        hc::arena_resource arena(4096, &upstream);
+        
+        // Every container, and each SoA component array, starts on a cache line
+        hc::quat_vector<float> v(37, &arena);
+        hc::quat_vector<double> d(5, &arena);
+        hc::quat_soa_vector<float> soa(37, &arena);
+        TEST_ASSERT(aligned64(v.data()) && aligned64(d.data()), "quat_vector data should be 64-byte aligned");
+        TEST_ASSERT(aligned64(soa.w()) && aligned64(soa.x()) && aligned64(soa.y()) && aligned64(soa.z()),
+                    "Each SoA component array should be 64-byte aligned");
+        TEST_ASSERT(arena_frame(arena), "Regrown arrays should stay 64-byte aligned");
+        
+        // The first reset merges the frame's chunks into one; later frames reuse it
+        size_t used = arena.capacity();
+        TEST_ASSERT(used > 4096, "The frame should have spilled past the first chunk");
+        arena.reset();
+        size_t allocations = upstream.allocations;
+        TEST_ASSERT(arena.capacity() == used, "reset() should merge the chunks, keeping the capacity");
+        TEST_ASSERT(upstream.outstanding == used, "The chunks replaced by the merge should go back upstream");
+        for (int frame = 0; frame < 4; frame++) {
+            TEST_ASSERT(arena_frame(arena), "Frame arrays should be 64-byte aligned");
+            arena.reset();
+        }
+        TEST_ASSERT(upstream.allocations == allocations, "Steady frames should not allocate upstream");
+        TEST_ASSERT(arena.capacity() == used, "Capacity should stay stable across frames");
+        
+        // release() hands everything back, and the arena still works afterwards
+        arena.release();
+        TEST_ASSERT(arena.capacity() == 0 && upstream.outstanding == 0, "release() should return every chunk");
+        TEST_ASSERT(arena_frame(arena), "The arena should allocate again after release()");
+        TEST_ASSERT(upstream.outstanding > 0, "Allocating after release() should go upstream");
+    }
+    TEST_ASSERT(upstream.outstanding == 0, "The destructor should return every chunk");
+    
+    return 1;
+}
+
+int test_soa_multiply() {
+    const size_t n = 37;                            // Not a multiple of any vector width
+    std::vector<hc::quaternionf> a(n), b(n), product(n), out(n);
+    hc::arena_resource arena(4096);
+    
+    for (size_t i = 0; i < n; i++) {
+        float f = static_cast<float>(i);
+        a[i] = hc::quaternionf(1.0f + f, 0.5f * f, -0.25f * f, 2.0f);
+        b[i] = hc::quaternionf(0.5f, 1.0f - f, 0.125f * f, -1.0f);
+        product[i] = a[i] * b[i];
+    }
+    
+    hc::quat_soa_vector<float> sa(&arena), sb(&arena), sout(&arena);
+    sa.assign(a.data(), n);
+    sb.assign(b.data(), n);
+    TEST_ASSERT(hc::multiply(sa, sb, sout) == HC_SUCCESS, "SoA multiply should succeed");
+    TEST_ASSERT(sout.size() == n, "SoA multiply should resize the output");
+    sout.copy_to(out.data());
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(product[i], out[i]), "SoA multiply should match operator*");
+    }
+    
+    // out aliasing either input
+    hc::quat_soa_vector<float> x(&arena);
+    x.assign(a.data(), n);
+    TEST_ASSERT(hc::multiply(x, sb, x) == HC_SUCCESS, "SoA multiply into the left input should succeed");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(product[i], x[i]), "SoA multiply into the left input should match");
+    }
+    x.assign(b.data(), n);
+    TEST_ASSERT(hc::multiply(sa, x, x) == HC_SUCCESS, "SoA multiply into the right input should succeed");
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT(near(product[i], x[i]), "SoA multiply into the right input should match");
+    }
+    
+    // Sizes that differ are rejected and leave out alone
+    hc::quat_soa_vector<float> shorter(n - 1, &arena);
+    TEST_ASSERT(hc::multiply(sa, shorter, sout) == HC_ERROR_INVALID_DATA, "Mismatched sizes should be rejected");
+    TEST_ASSERT(sout.size() == n && near(product[n - 1], sout[n - 1]), "A rejected multiply should not touch out");
+    
+    return 1;
+}
+
+#endif /* HC_HAVE_PMR */
+
+#ifdef HC_HAVE_EXECUTION
+
+/*
+ * Parallel algorithms: the library path must match the standard algorithm,
+ * and only contiguous quaternionf ranges under a non-seq policy may take it
+ */
+
+static_assert(!hc::detail::library_policy_v<const std::execution::sequenced_policy&>, "seq takes std::transform");
+static_assert(hc::detail::library_policy_v<const std::execution::parallel_unsequenced_policy&>, "par_unseq takes the kernels");
+static_assert(!hc::detail::quaternionf_range_v<hc::quaterniond*>, "Double ranges take the standard algorithm");
+static_assert(!hc::detail::quaternionf_range_v<std::list<hc::quaternionf>::iterator>, "Lists are not contiguous");
+
+// Batch calls made through the stats counters, or 0 when they are compiled out
+static unsigned long long batch_calls(hc_api_t api) {
+    hc_stats_t stats;
+    return hc_stats_snapshot(&stats) == HC_SUCCESS ? stats.apis[api].calls : 0;
+}
+
+int test_parallel_algorithms() {
+    const size_t n = 1000;
+    std::vector<hc::quaternionf> a(n), b(n), out(n), expected(n);
+    hc_tuning_t saved, t;
+    
+    for (size_t i = 0; i < n; i++) {
+        float f = static_cast<float>(i % 53);
+        a[i] = hc::normalized(hc::quaternionf(1.0f + f, 0.5f * f, -0.25f * f, 2.0f));
+        b[i] = hc::normalized(hc::quaternionf(0.5f, 1.0f - f, 0.125f * f, -1.0f));
+    }
+    a[7] = hc::quaternionf();                       // Passes through normalize unchanged
+    
+    // Split the kernels across the pool so the library path is not just an inline loop
+    hc_tuning_get(&saved);
+    hc_tuning_default(&t);
+    t.threads = 4;
+    t.chunk_elements = 64;
+    hc_tuning_set(&t);
+    bool counting = hc_stats_enable(HC_STATS_COUNTERS) == HC_SUCCESS;
+    
+    std::transform(a.begin(), a.end(), b.begin(), expected.begin(), hc::ops::multiply{});
+    unsigned long long calls = batch_calls(HC_API_MULTIPLY_BATCH);
+    hc::transform(std::execution::par_unseq, a.begin(), a.end(), b.begin(), out.begin(), hc::ops::multiply{});
+    for (size_t i = 0; i < n; i++) TEST_ASSERT(near(expected[i], out[i]), "par_unseq multiply should match std::transform");
+    TEST_ASSERT(!counting || batch_calls(HC_API_MULTIPLY_BATCH) == calls + 1, "par_unseq multiply should run the batch kernel");
+    
+    std::transform(a.begin(), a.end(), expected.begin(), hc::ops::normalize{});
+    calls = batch_calls(HC_API_NORMALIZE_BATCH);
+    hc::transform(std::execution::par_unseq, a.data(), a.data() + n, out.data(), hc::ops::normalize{});
+    for (size_t i = 0; i < n; i++) TEST_ASSERT(near(expected[i], out[i]), "par_unseq normalize should match std::transform");
+    TEST_ASSERT(!counting || batch_calls(HC_API_NORMALIZE_BATCH) == calls + 1, "par_unseq normalize should run the batch kernel");
+    
+    // seq, double ranges and lists go to the standard algorithm; unseq keeps
+    // the fallback serial, so the suite does not need a parallel backend (TBB)
+    calls = batch_calls(HC_API_NORMALIZE_BATCH);
+    hc::transform(std::execution::seq, a.begin(), a.end(), out.begin(), hc::ops::normalize{});
+    for (size_t i = 0; i < n; i++) TEST_ASSERT(near(expected[i], out[i]), "seq normalize should match std::transform");
+    TEST_ASSERT(!counting || batch_calls(HC_API_NORMALIZE_BATCH) == calls, "seq should not run the batch kernel");
+    
+    std::vector<hc::quaterniond> d(n), dout(n);
+    for (size_t i = 0; i < n; i++) d[i] = hc::quaterniond(a[i].w, a[i].x, a[i].y, a[i].z);
+    hc::transform(std::execution::unseq, d.begin(), d.end(), d.begin(), dout.begin(), hc::ops::multiply{});
+    for (size_t i = 0; i < n; i++) TEST_ASSERT(near(d[i] * d[i], dout[i]), "Double multiply should match the operator");
+    
+    std::list<hc::quaternionf> la(a.begin(), a.end()), lout(n);
+    hc::transform(std::execution::unseq, la.begin(), la.end(), lout.begin(), hc::ops::conjugate{});
+    auto it = lout.begin();
+    for (size_t i = 0; i < n; i++, ++it) TEST_ASSERT(*it == hc::conjugate(a[i]), "List conjugate should match the operator");
+    
+    // The product keeps its order: a left fold from init, with init on the left
+    const hc::quaternionf init = hc::normalized(hc::quaternionf(0.2f, -0.7f, 0.4f, 0.1f));
+    hc::quaternionf left = std::accumulate(b.begin(), b.end(), init, hc::ops::multiply{});
+    hc::quaternionf reversed = std::accumulate(b.rbegin(), b.rend(), hc::quaternionf(1.0f, 0.0f, 0.0f, 0.0f),
+                                               hc::ops::multiply{}) * init;
+    hc::quaternionf product = hc::reduce(std::execution::par_unseq, b.begin(), b.end(), init, hc::ops::multiply{});
+    TEST_ASSERT(near(left, product, 1e-3f), "Parallel product should match the left fold");
+    TEST_ASSERT(!near(reversed, product, 1e-1f), "Parallel product should not depend on commuting the factors");
+    TEST_ASSERT(near(init * b[0] * b[1], hc::reduce(std::execution::par_unseq, b.begin(), b.begin() + 2, init,
+                                                    hc::ops::multiply{}), 1e-6f), "init should multiply on the left");
+    TEST_ASSERT(hc::reduce(std::execution::par_unseq, b.begin(), b.begin(), init, hc::ops::multiply{}) == init,
+                "An empty product should return init");
+    
+    // The two-argument form sums
+    hc::quaternionf sum = std::accumulate(a.begin(), a.end(), hc::quaternionf());
+    TEST_ASSERT(near(sum, hc::reduce(std::execution::par_unseq, a.begin(), a.end()), 1e-3f), "Parallel reduce should sum");
+    TEST_ASSERT(near(sum, hc::reduce(std::execution::seq, a.begin(), a.end()), 1e-3f), "seq reduce should sum");
+    
+    if (counting) hc_stats_enable(0);
+    hc_tuning_set(&saved);
+    return 1;
+}
+
+#endif /* HC_HAVE_EXECUTION */
+
+#ifdef HC_HAVE_COROUTINES
+
+/*
+ * Coroutine tests: a detached coroutine drives the awaitables, and the test
+ * thread waits on a latch for it to finish
+ */
+
+struct latch {
+    std::mutex lock;
+    std::condition_variable cond;
+    bool done = false;
+    
+    void signal() {
+        std::lock_guard<std::mutex> guard(lock);
+        done = true;
+        cond.notify_all();
+    }
+    
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [this] { return done; });
+    }
+};
+
+struct detached {
+    struct promise_type {
+        detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+struct async_result {
+    int status = 1;
+    size_t cipher_length = 0;
+    std::thread::id resumed_on;
+};
+
+static detached encrypt_one(const void* message, size_t length, quaternion_t key,
+                            void* ciphertext, async_result* result, latch* finished) {
+    result->cipher_length = hypercomplex_cipher_length(length);
+    result->status = co_await hc::encrypt_async(message, length, key, ciphertext, &result->cipher_length);
+    result->resumed_on = std::this_thread::get_id();
+    finished->signal();
+}
+
+int test_encrypt_async() {
+    static const uint8_t message[100] = "awaited on the worker pool";
+    std::vector<uint8_t> ciphertext(hypercomplex_cipher_length(sizeof(message)));
+    std::vector<uint8_t> expected(ciphertext.size());
+    size_t expected_length = expected.size();
+    quaternion_t key;
+    async_result result;
+    latch finished;
+    
+    quaternion_generate_key(&key, 4242ULL);
+    encrypt_one(message, sizeof(message), key, ciphertext.data(), &result, &finished);
+    finished.wait();
+    
+    // The coroutine resumed on the pool thread that did the work
+    TEST_ASSERT(result.status == HC_SUCCESS, "Awaited encryption should succeed");
+    TEST_ASSERT(result.resumed_on != std::this_thread::get_id(), "Coroutine should resume on a pool thread");
+    
+    hypercomplex_encrypt_data(message, sizeof(message), &key, expected.data(), &expected_length);
+    TEST_ASSERT(result.cipher_length == expected_length, "Awaited cipher length should match");
+    TEST_ASSERT(std::memcmp(ciphertext.data() + sizeof(hypercomplex_header_t), expected.data() + sizeof(hypercomplex_header_t),
+                            expected_length - sizeof(hypercomplex_header_t)) == 0, "Awaited ciphertext should match");
+    
+    // Errors come back through co_await, like the C status codes
+    finished.done = false;
+    encrypt_one(nullptr, sizeof(message), key, ciphertext.data(), &result, &finished);
+    finished.wait();
+    TEST_ASSERT(result.status == HC_ERROR_NULL_PTR, "Awaited error should be returned");
+    
+    return 1;
+}
+
+struct chunk_record {
+    size_t offset;
+    int status;
+    int decrypt_status;
+    std::vector<hc::quaternionf> plain;
+};
+
+static detached collect_chunks(const hc::quaternionf* payload, size_t bytes, quaternion_t key, size_t chunk_bytes,
+                               std::vector<chunk_record>* chunks, latch* finished) {
+    auto stream = hc::encrypt_chunks(payload, bytes, key, chunk_bytes);
+    
+    while (const hc::encrypted_chunk* c = co_await stream.next()) {
+        chunk_record record{ c->offset, c->status, 1, {} };
+        
+        // Each chunk carries its own header and decrypts on its own
+        if (c->status == HC_SUCCESS) {
+            std::vector<hc::quaternionf> plain(c->size / sizeof(hc::quaternionf) + 1);
+            size_t plain_length = plain.size() * sizeof(hc::quaternionf);
+            record.decrypt_status = hypercomplex_decrypt_data(c->data, c->size, &key, plain.data(), &plain_length);
+            plain.resize(plain_length / sizeof(hc::quaternionf));
+            record.plain = std::move(plain);
+        }
+        chunks->push_back(std::move(record));
+    }
+    finished->signal();
+}
+
+int test_encrypt_chunks() {
+    constexpr size_t COUNT = 13, PER_CHUNK = 4;
+    hc::quaternionf payload[COUNT];
+    std::vector<chunk_record> chunks;
+    quaternion_t key;
+    latch finished;
+    
+    for (size_t i = 0; i < COUNT; i++) {
+        float f = static_cast<float>(i);
+        payload[i] = hc::quaternionf(1.5f * f, -2.0f + f, 0.25f * f * f, 3.0f);
+    }
+    quaternion_generate_key(&key, 777ULL);
+    
+    collect_chunks(payload, sizeof(payload), key, PER_CHUNK * sizeof(hc::quaternionf), &chunks, &finished);
+    finished.wait();
+    
+    TEST_ASSERT(chunks.size() == (COUNT + PER_CHUNK - 1) / PER_CHUNK, "One chunk per chunk_bytes of plaintext");
+    for (size_t k = 0; k < chunks.size(); k++) {
+        const chunk_record& c = chunks[k];
+        size_t first = k * PER_CHUNK;
+        size_t expected = COUNT - first < PER_CHUNK ? COUNT - first : PER_CHUNK;
+        
+        TEST_ASSERT(c.status == HC_SUCCESS, "Chunk encryption should succeed");
+        TEST_ASSERT(c.offset == first * sizeof(hc::quaternionf), "Chunks should cover the plaintext in order");
+        TEST_ASSERT(c.decrypt_status == HC_SUCCESS, "Chunk should decrypt on its own");
+        TEST_ASSERT(c.plain.size() == expected, "Decrypted chunk length should match");
+        TEST_ASSERT(std::memcmp(payload + first, c.plain.data(), expected * sizeof(hc::quaternionf)) == 0,
+                    "Decrypted chunk should match the plaintext exactly");
+    }
+    
+    return 1;
+}
+
+#endif /* HC_HAVE_COROUTINES */
+
+void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %d\n", total_tests);
+    printf("Passed: %d\n", passed_tests);
+    printf("Failed: %d\n", failed_tests);
+}
+
+int main() {
+    printf("Hypercomplex C++ Interface Test Suite\n");
+    printf("=====================================\n");
+
+    RUN_TEST(test_fixed_size_kernels);
+    RUN_TEST(test_unit_from);
+    RUN_TEST(test_expression_templates);
+#ifdef HC_HAVE_PMR
+    RUN_TEST(test_arena_resource);
+    RUN_TEST(test_soa_multiply);
+#else
+    printf("pmr tests skipped: the standard library has no <memory_resource>\n");
+#endif
+#ifdef HC_HAVE_EXECUTION
+    RUN_TEST(test_parallel_algorithms);
+#else
+    printf("Parallel algorithm tests skipped: the standard library has no <execution>\n");
+#endif
+#ifdef HC_HAVE_COROUTINES
+    RUN_TEST(test_encrypt_async);
+    RUN_TEST(test_encrypt_chunks);
+#else
+    printf("Coroutine tests skipped: the compiler has no C++20 coroutines\n");
+#endif
+
+    print_test_summary();
+    
+    return (failed_tests == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
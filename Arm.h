@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +21,21 @@ typedef struct {
     float w, x, y, z;
 } quaternion_t;
 
+#ifdef __cplusplus
+#define HC_ALIGNAS(n) alignas(n)
+#else
+#define HC_ALIGNAS(n) _Alignas(n)
+#endif
+
+/**
+ * quaternion_t on a 16-byte boundary: same layout, but an element never
+ * straddles a cache line and a whole one fits a single aligned SIMD load
+ */
+typedef struct {
+    HC_ALIGNAS(16) float w;
+    float x, y, z;
+} quaternion_a16_t;
+
 typedef struct {
     uint32_t magic;           // 0xDEADBEEF for validation
     size_t length;           // Data length in bytes
@@ -34,6 +50,8 @@ typedef struct {
 #define HC_ERROR_NULL_PTR  -1
 #define HC_ERROR_DIVIDE_ZERO -2
 #define HC_ERROR_INVALID_DATA -3
+#define HC_ERROR_NO_MEMORY -4
+#define HC_ERROR_UNSUPPORTED -5
 
 /*
  * Assembly Function Declarations
@@ -76,208 +94,7161 @@ int quaternion_is_valid(const quaternion_t* q);
 void quaternion_generate_key(quaternion_t* key, uint64_t seed);
 
 /**
- * High-level encryption function with integrity checking
+ * High-level encryption function with integrity checking. The message is
+ * carried as 16-bit words widened to floats, 8 bytes per 16-byte block, so
+ * the ciphertext is twice the padded message (see hypercomplex_cipher_length)
  */
 int hypercomplex_encrypt_data(const void* plaintext, size_t length, 
                              const quaternion_t* key, void* ciphertext, 
                              size_t* cipher_length);
 
-/**
- * High-level decryption function
+/**
+ * High-level decryption function; the round trip is byte-exact
+ */
+int hypercomplex_decrypt_data(const void* ciphertext, size_t cipher_length,
+                             const quaternion_t* key, void* plaintext,
+                             size_t* plain_length);
+
+/**
+ * Batch operations over arrays of quaternions, element by element.
+ * In-place use (result aliasing an input) is allowed.
+ */
+int quaternion_multiply_batch(const quaternion_t* q1, const quaternion_t* q2,
+                              quaternion_t* result, size_t count);
+int quaternion_add_batch(const quaternion_t* q1, const quaternion_t* q2,
+                         quaternion_t* result, size_t count);
+int quaternion_conjugate_batch(const quaternion_t* input, quaternion_t* result, size_t count);
+
+/**
+ * Normalize every element; near-zero elements are copied unchanged and
+ * reported with HC_ERROR_DIVIDE_ZERO after the whole array is processed
+ */
+int quaternion_normalize_batch(const quaternion_t* input, quaternion_t* result, size_t count);
+
+/**
+ * Reductions over an array: the component-wise sum, and the Hamilton product
+ * q[0] * q[1] * ... * q[count - 1] in that order. Empty arrays give zero and
+ * the identity. Large arrays are split across the worker pool like the batch
+ * calls; the sum's rounding then depends on the split.
+ */
+int quaternion_sum(const quaternion_t* q, size_t count, quaternion_t* result);
+int quaternion_product(const quaternion_t* q, size_t count, quaternion_t* result);
+
+/**
+ * Inverse, rotation of a 3-vector (q v q^-1) and spherical interpolation for
+ * arbitrary quaternions. Each call checks its inputs (HC_ERROR_INVALID_DATA
+ * for NaN or Inf, HC_ERROR_DIVIDE_ZERO for a near-zero quaternion) and
+ * normalizes them; callers with unit quaternions should use the unit_ calls.
+ */
+int quaternion_inverse(const quaternion_t* q, quaternion_t* result);
+int quaternion_rotate(const quaternion_t* q, const float v[3], float result[3]);
+int quaternion_slerp(const quaternion_t* a, const quaternion_t* b, float t, quaternion_t* result);
+
+/**
+ * A quaternion known to have norm 1. The invariant is established once, by
+ * unit_quaternion_make or unit_quaternion_generate_key, and the unit_ calls
+ * then skip validation and normalization: the inverse is the conjugate,
+ * rotation needs no division and SLERP no renormalization. Products of unit
+ * quaternions stay unit up to rounding; unit_quaternion_renormalize pulls a
+ * long chain back cheaply. Builds without NDEBUG assert that every unit
+ * input is within HC_UNIT_TOLERANCE of norm 1.
+ */
+#define HC_UNIT_TOLERANCE 1e-3f     // Allowed |norm^2 - 1|
+
+typedef struct {
+    quaternion_t q;
+} unit_quaternion_t;
+
+int unit_quaternion_make(const quaternion_t* q, unit_quaternion_t* result);
+void unit_quaternion_generate_key(unit_quaternion_t* key, uint64_t seed);
+int unit_quaternion_multiply(const unit_quaternion_t* a, const unit_quaternion_t* b, unit_quaternion_t* result);
+int unit_quaternion_inverse(const unit_quaternion_t* q, unit_quaternion_t* result);
+int unit_quaternion_rotate(const unit_quaternion_t* q, const float v[3], float result[3]);
+int unit_quaternion_slerp(const unit_quaternion_t* a, const unit_quaternion_t* b, float t,
+                          unit_quaternion_t* result);
+void unit_quaternion_renormalize(unit_quaternion_t* q);
+
+/**
+ * Arrays of quaternion_a16_t starting on a cache line, from hc_aligned_alloc.
+ * Returns NULL for count 0 or when the allocation fails.
+ */
+#define HC_ARRAY_ALIGNMENT 64
+
+quaternion_a16_t* hc_quaternion_array_alloc(size_t count);
+void hc_quaternion_array_free(quaternion_a16_t* array);
+
+/**
+ * Batch operations that rely on 16-byte aligned arrays and use aligned SIMD
+ * loads and stores. Same semantics as the unaligned calls; any misaligned
+ * pointer fails with HC_ERROR_INVALID_DATA before touching memory.
+ */
+int quaternion_multiply_batch_aligned(const quaternion_a16_t* q1, const quaternion_a16_t* q2,
+                                      quaternion_a16_t* result, size_t count);
+int quaternion_add_batch_aligned(const quaternion_a16_t* q1, const quaternion_a16_t* q2,
+                                 quaternion_a16_t* result, size_t count);
+int quaternion_conjugate_batch_aligned(const quaternion_a16_t* input, quaternion_a16_t* result, size_t count);
+int quaternion_normalize_batch_aligned(const quaternion_a16_t* input, quaternion_a16_t* result, size_t count);
+
+/**
+ * Aligned allocation for large quaternion arrays and message buffers.
+ * Memory from hc_aligned_alloc must be released with hc_aligned_free.
+ */
+void* hc_aligned_alloc(size_t size, size_t alignment);
+void hc_aligned_free(void* ptr);
+
+/**
+ * Huge pages for hc_aligned_alloc requests of at least HC_HUGE_PAGE_MIN bytes.
+ * THP maps 2 MiB-aligned memory and asks for transparent huge pages with
+ * MADV_HUGEPAGE. HUGETLB takes pages from the reserved hugetlbfs pool
+ * (vm.nr_hugepages) with MAP_HUGETLB and falls back to THP when the pool is
+ * empty. Off by default; HC_ERROR_UNSUPPORTED where neither exists.
+ */
+typedef enum {
+    HC_HUGE_PAGES_OFF = 0,
+    HC_HUGE_PAGES_THP,
+    HC_HUGE_PAGES_HUGETLB
+} hc_huge_pages_t;
+
+#define HC_HUGE_PAGE_MIN ((size_t)2 << 20)
+
+int hc_huge_pages_set(hc_huge_pages_t mode);
+hc_huge_pages_t hc_huge_pages_get(void);
+const char* hc_huge_pages_name(hc_huge_pages_t mode);
+
+/**
+ * How an allocation from hc_aligned_alloc is backed. THP is advice to the
+ * kernel, so that result means huge pages were requested, not guaranteed.
+ */
+hc_huge_pages_t hc_aligned_backing(const void* ptr);
+
+/**
+ * Pooled message buffers, 64-byte aligned, in power-of-two size classes up to
+ * HC_BUFFER_MAX_POOLED; larger requests are allocated and freed directly.
+ * Each thread caches released buffers and refills from a shared pool, so a
+ * steady acquire/release loop doesn't reach malloc. A buffer may be released
+ * on any thread.
+ *
+ * Release and capacity read a header just before the buffer, so they take
+ * only pointers from hc_buffer_acquire (or NULL); anything else is undefined.
+ * Releasing the same buffer twice is ignored, and builds without NDEBUG
+ * assert on it. A release after the pool has handed the buffer out again
+ * cannot be told apart from the new owner's.
+ */
+#define HC_BUFFER_MAX_POOLED ((size_t)1 << 20)
+
+void* hc_buffer_acquire(size_t size);
+void hc_buffer_release(void* buffer);
+size_t hc_buffer_capacity(const void* buffer);
+
+/**
+ * Free the buffers held in the shared pool (thread caches are left alone)
+ */
+void hc_buffer_trim(void);
+
+/**
+ * Ciphertext size for a message: header plus one 16-byte block per 8 bytes
+ */
+size_t hypercomplex_cipher_length(size_t length);
+
+/**
+ * hypercomplex_encrypt_data into a pooled buffer; on success the caller
+ * owns *ciphertext and returns it with hc_buffer_release
+ */
+int hypercomplex_encrypt_data_pooled(const void* plaintext, size_t length,
+                                     const quaternion_t* key, void** ciphertext,
+                                     size_t* cipher_length);
+
+/**
+ * Runtime statistics per API (calls, bytes, time, errors by code).
+ * Compiled in with -DHC_ENABLE_STATS and switched on with hc_stats_enable;
+ * without the define the hooks compile away and the calls below return
+ * HC_ERROR_UNSUPPORTED.
+ */
+typedef enum {
+    HC_API_GENERATE_KEY = 0,
+    HC_API_ENCRYPT_DATA,
+    HC_API_DECRYPT_DATA,
+    HC_API_MULTIPLY_BATCH,
+    HC_API_ADD_BATCH,
+    HC_API_CONJUGATE_BATCH,
+    HC_API_NORMALIZE_BATCH,
+    HC_API_COUNT
+} hc_api_t;
+
+#define HC_STATS_COUNTERS   0x1u     // Count calls, bytes, time and errors
+#define HC_STATS_ERROR_SLOTS 6       // errors[-code] for each HC_ERROR_*; slot 0 collects unknown codes
+
+typedef struct {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t total_ns;
+    uint64_t errors[HC_STATS_ERROR_SLOTS];
+} hc_api_stats_t;
+
+typedef struct {
+    hc_api_stats_t apis[HC_API_COUNT];
+} hc_stats_t;
+
+int hc_stats_enable(unsigned flags);
+unsigned hc_stats_enabled(void);
+
+/**
+ * Sum every thread's counters since the last reset
+ */
+int hc_stats_snapshot(hc_stats_t* stats);
+void hc_stats_reset(void);
+const char* hc_api_name(hc_api_t api);
+
+/**
+ * Latency histograms per API and payload size class.
+ * Log-bucketed like HDR Histogram: values below 2^HC_HIST_SUB_BITS ns are exact,
+ * above that each power of two splits into 2^HC_HIST_SUB_BITS buckets (~6% width).
+ */
+#define HC_STATS_HISTOGRAMS 0x2u     // Record per-call latency histograms
+#define HC_HIST_SUB_BITS    4
+#define HC_HIST_MAX_SHIFT   36       // Anything past ~2^41 ns (~36 minutes) lands in the top bucket
+#define HC_HIST_BUCKETS     ((HC_HIST_MAX_SHIFT + 2) << HC_HIST_SUB_BITS)
+
+typedef enum {
+    HC_SIZE_CLASS_64 = 0,            // Up to 64 bytes
+    HC_SIZE_CLASS_512,
+    HC_SIZE_CLASS_4K,
+    HC_SIZE_CLASS_64K,
+    HC_SIZE_CLASS_LARGE,             // Above 64 KiB
+    HC_SIZE_CLASS_COUNT
+} hc_size_class_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t buckets[HC_HIST_BUCKETS];
+} hc_histogram_t;
+
+hc_size_class_t hc_size_class(size_t bytes);
+const char* hc_size_class_name(hc_size_class_t size_class);
+
+/**
+ * Sum every thread's histogram for one API and size class since the last reset
+ */
+int hc_histogram_snapshot(hc_api_t api, hc_size_class_t size_class, hc_histogram_t* hist);
+void hc_histogram_record(hc_histogram_t* hist, uint64_t ns);
+void hc_histogram_merge(hc_histogram_t* into, const hc_histogram_t* from);
+
+/**
+ * Latency at a percentile (0-100], reported as the top of its bucket; 0 when empty
+ */
+uint64_t hc_histogram_percentile(const hc_histogram_t* hist, double percentile);
+uint64_t hc_histogram_max(const hc_histogram_t* hist);
+
+/**
+ * Flight recorder: each thread keeps its last HC_FLIGHT_RING_SIZE calls that
+ * took at least the threshold. Needs -DHC_ENABLE_STATS like the counters.
+ */
+#define HC_FLIGHT_RING_SIZE 256
+
+typedef struct {
+    uint64_t timestamp_ns;           // Wall-clock start of the call (CLOCK_REALTIME)
+    uint64_t duration_ns;
+    uint64_t bytes;
+    hc_api_t api;
+    int backend;                     // hc_backend_t that ran the call
+    int status;
+    uint32_t thread_id;              // Kernel thread id on Linux
+} hc_flight_entry_t;
+
+/**
+ * Record calls at or above threshold_ns; 0 turns recording off
+ */
+int hc_flight_enable(uint64_t threshold_ns);
+uint64_t hc_flight_threshold(void);
+
+/**
+ * Forget every recorded entry. Safe while other threads are recording; a call
+ * recorded during the reset may survive it.
+ */
+void hc_flight_reset(void);
+
+/**
+ * Copy out the most recent entries across all threads, oldest first. An entry
+ * being overwritten during the copy is left out rather than returned half-written.
+ */
+int hc_flight_snapshot(hc_flight_entry_t* entries, size_t capacity, size_t* count);
+
+/**
+ * Write every thread's ring as text to fd. Async-signal-safe; an entry being
+ * overwritten while the dump runs is left out.
+ */
+int hc_flight_dump(int fd);
+
+/**
+ * Dump to fd whenever signo arrives (0 means SIGUSR2)
+ */
+int hc_flight_install_signal(int signo, int fd);
+
+/**
+ * Prometheus text exposition of the statistics above, plus the batch backend
+ * and thread count in use. Returns the full length like snprintf; pass a
+ * NULL buffer to size it.
+ */
+size_t hc_stats_format_prometheus(char* buffer, size_t capacity);
+
+/**
+ * Serve the exposition over HTTP from a background thread, on a Unix socket or
+ * on 127.0.0.1:port. One exporter per process; scrapes only read the per-thread
+ * counters, so the hot path stays lock-free.
+ */
+int hc_exporter_start_unix(const char* path);
+int hc_exporter_start_tcp(uint16_t port);
+void hc_exporter_stop(void);
+
+/**
+ * Hardware performance counters (perf_event_open on Linux)
+ */
+typedef enum {
+    HC_COUNTER_CYCLES = 0,
+    HC_COUNTER_INSTRUCTIONS,
+    HC_COUNTER_L1D_MISSES,           // L1 data cache read misses
+    HC_COUNTER_LLC_MISSES,           // Last-level cache misses
+    HC_COUNTER_BRANCH_MISSES,
+    HC_COUNTER_DTLB_MISSES,          // Data TLB read misses
+    HC_COUNTER_FP_ASSISTS,           // Raw event from HC_PERF_FP_ASSIST_EVENT, if set
+    HC_COUNTER_COUNT
+} hc_counter_t;
+
+typedef struct {
+    uint32_t available;              // Bit (1 << counter) set when the value was read
+    uint64_t values[HC_COUNTER_COUNT];
+} hc_hw_counters_t;
+
+typedef struct {
+    int fds[HC_COUNTER_COUNT];
+    int leader;                      // Counter whose fd leads the group, or -1
+    uint32_t grouped;                // Bit (1 << counter) set for the group's members
+} hc_perf_session_t;
+
+/**
+ * Open the counters this host allows; HC_ERROR_UNSUPPORTED when none are.
+ * They are opened as one group, so every value covers the same instants and
+ * ratios such as IPC are exact. When the PMU cannot hold the whole group, the
+ * last counters are split off to count on their own, multiplexed and scaled.
+ * Counting covers the calling thread only: work that split calls hand to the
+ * worker pool (hc_tuning_t.threads > 1) is not included.
+ */
+int hc_perf_open(hc_perf_session_t* session);
+
+/**
+ * Reset and start counting on the calling thread
+ */
+int hc_perf_start(hc_perf_session_t* session);
+
+/**
+ * Stop counting and read values, scaled when the kernel multiplexed them
+ */
+int hc_perf_stop(hc_perf_session_t* session, hc_hw_counters_t* counters);
+
+void hc_perf_close(hc_perf_session_t* session);
+const char* hc_counter_name(hc_counter_t counter);
+
+/**
+ * Performance benchmarking
+ */
+typedef struct {
+    uint64_t operations_per_second;
+    double average_latency_ns;
+    size_t bytes_processed;
+    double cycles_per_op;            // Core cycles, from the calibrated clock estimate
+    
+    // Distribution of ns/op: latency runs sample every HC_BENCH_LATENCY_CALLS
+    // calls, other runs once per repetition; stddev and ci95 are of the
+    // per-repetition means either way
+    size_t repetitions;
+    size_t samples;                  // Samples behind min, median and the percentiles
+    double min_ns;
+    double median_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double stddev_ns;
+    double ci95_ns;                  // Half-width of the 95% confidence interval of the mean
+    
+    // Totals over all repetitions; cycles_per_op uses the cycle counter when present
+    size_t operations;
+    hc_hw_counters_t hw;
+} perf_stats_t;
+
+int hypercomplex_benchmark(size_t iterations, perf_stats_t* stats);
+
+/**
+ * Benchmark suite covering every public operation
+ */
+typedef enum {
+    HC_OP_MULTIPLY = 0,
+    HC_OP_ADD,
+    HC_OP_CONJUGATE,
+    HC_OP_NORM,
+    HC_OP_NORMALIZE,
+    HC_OP_IS_VALID,
+    HC_OP_GENERATE_KEY,
+    HC_OP_ENCRYPT,
+    HC_OP_ENCRYPT_DATA,
+    HC_OP_DECRYPT_DATA,
+    HC_OP_MULTIPLY_BATCH,
+    HC_OP_ADD_BATCH,
+    HC_OP_CONJUGATE_BATCH,
+    HC_OP_NORMALIZE_BATCH,
+    HC_OP_COUNT
+} hc_op_t;
+
+// Elements processed per call by the batch operations in hc_bench_run
+#define HC_BENCH_BATCH_COUNT 1024
+
+// Calls per latency sample in HC_BENCH_LATENCY runs: one clock read per sample
+// keeps the timer cost to a fraction of a nanosecond per call. Very long runs
+// use larger samples, at most HC_BENCH_MAX_SAMPLES per repetition.
+#define HC_BENCH_LATENCY_CALLS 64
+#define HC_BENCH_MAX_SAMPLES 4096
+
+// hc_bench_config_t.cpu: pin to whichever core the run starts on
+#define HC_BENCH_CPU_CURRENT (-2)
+
+typedef enum {
+    HC_BENCH_LATENCY = 0,            // Dependent chain: each op consumes the previous result
+    HC_BENCH_THROUGHPUT              // Independent stream: no data flows between ops
+} hc_bench_mode_t;
+
+typedef struct {
+    size_t iterations;               // Measured operations per repetition
+    size_t repetitions;              // Timed repetitions, one sample each
+    size_t warmup;                   // Unmeasured operations run first
+    size_t payload_bytes;            // Message size for the encryption operations
+    uint64_t seed;                   // Seed for the randomized inputs
+    int cpu;                         // Core to pin the run to, HC_BENCH_CPU_CURRENT (the default)
+                                     // for the core it starts on, or -1 to leave it unpinned
+    int hw_counters;                 // Read hardware counters around the measured region
+} hc_bench_config_t;
+
+typedef struct {
+    hc_op_t op;
+    hc_bench_mode_t mode;
+    size_t payload_bytes;
+    perf_stats_t stats;
+    const char* backend;             // Implementation measured; NULL reads as "default"
+} hc_bench_result_t;
+
+/**
+ * One row of a saved baseline, as read back from a CSV report
+ */
+typedef struct {
+    hc_op_t op;
+    hc_bench_mode_t mode;
+    size_t payload_bytes;
+    char backend[32];
+    size_t repetitions;
+    double mean_ns;
+    double stddev_ns;
+} hc_bench_baseline_t;
+
+/**
+ * Fill a benchmark configuration with the defaults
+ */
+void hc_bench_default_config(hc_bench_config_t* config);
+
+/**
+ * Printable names for operations and modes
+ */
+const char* hc_op_name(hc_op_t op);
+const char* hc_bench_mode_name(hc_bench_mode_t mode);
+
+/**
+ * Estimated core clock in GHz, calibrated once with a dependent add chain
+ */
+double hc_bench_cpu_ghz(void);
+
+/**
+ * Benchmark one operation in the given mode; a NULL config uses the defaults
+ */
+int hc_bench_run(hc_op_t op, hc_bench_mode_t mode,
+                 const hc_bench_config_t* config, perf_stats_t* stats);
+
+/**
+ * Cache hierarchy as seen by the working-set sweep. hc_cache_size returns
+ * bytes for level 1-3 (0 if absent); hc_cache_level returns the first level
+ * a working set fits in, or 4 when it spills to DRAM.
+ */
+size_t hc_cache_size(int level);
+int hc_cache_level(size_t working_set_bytes);
+
+/**
+ * Throughput of a bulk kernel (a batch op or HC_OP_ENCRYPT) over working sets
+ * doubling from min_bytes to max_bytes. Per-element stats are stored with
+ * payload_bytes set to the working set; the sweep stops early, keeping the
+ * points measured so far, when a size cannot be allocated.
+ */
+int hc_bench_sweep(hc_op_t op, const hc_bench_config_t* config,
+                   size_t min_bytes, size_t max_bytes,
+                   hc_bench_result_t* results, size_t capacity, size_t* count);
+
+/**
+ * Write benchmark results as machine-readable JSON or CSV
+ */
+int hc_bench_write_json(FILE* out, const hc_bench_result_t* results, size_t count);
+int hc_bench_write_csv(FILE* out, const hc_bench_result_t* results, size_t count);
+
+/**
+ * Read a baseline saved with hc_bench_write_csv; release entries with free()
+ */
+int hc_bench_read_baseline(FILE* in, hc_bench_baseline_t** entries, size_t* count);
+
+/**
+ * Compare results against a baseline, keyed by op, mode, payload size and
+ * backend. A row regresses when its mean ns/op is more than threshold_pct
+ * slower and Welch's t-test finds the difference significant at 95%. Each
+ * comparison is written to report when it is non-NULL.
+ */
+int hc_bench_compare(FILE* report, const hc_bench_result_t* results, size_t count,
+                     const hc_bench_baseline_t* baseline, size_t baseline_count,
+                     double threshold_pct, size_t* regressions);
+
+/**
+ * Interchangeable implementations of the core kernels, compared side by side
+ */
+typedef enum {
+    HC_BACKEND_SCALAR = 0,           // Plain C, one quaternion per call
+    HC_BACKEND_ASM,                  // Hand-written ARM64 core (aarch64 builds only)
+    HC_BACKEND_AUTOVEC,              // Batch loops left to the compiler's vectorizer
+    HC_BACKEND_SIMD,                 // NEON intrinsics on aarch64, SSE on x86-64
+    HC_BACKEND_COUNT
+} hc_backend_t;
+
+typedef enum {
+    HC_KERNEL_MULTIPLY = 0,
+    HC_KERNEL_ADD,
+    HC_KERNEL_CONJUGATE,
+    HC_KERNEL_NORM,
+    HC_KERNEL_NORMALIZE,
+    HC_KERNEL_COUNT
+} hc_kernel_t;
+
+typedef struct {
+    hc_kernel_t kernel;
+    hc_backend_t backend;
+    perf_stats_t stats;              // Per quaternion processed
+    float max_error;                 // Largest component difference from the scalar backend
+} hc_backend_result_t;
+
+const char* hc_backend_name(hc_backend_t backend);
+const char* hc_kernel_name(hc_kernel_t kernel);
+int hc_backend_available(hc_backend_t backend);
+
+/**
+ * Run every available backend of every kernel over the same seeded inputs,
+ * checking each output against the scalar backend before timing it
+ */
+int hc_bench_backends(const hc_bench_config_t* config, hc_backend_result_t* results,
+                      size_t capacity, size_t* count);
+
+/**
+ * Print a comparison table: ns, cycles and instructions per quaternion,
+ * speedup over the scalar backend and the largest error seen
+ */
+int hc_bench_print_backends(FILE* out, const hc_backend_result_t* results, size_t count);
+
+/**
+ * Roofline characterization: each kernel's arithmetic intensity and achieved
+ * GFLOP/s against the host's measured peak and stream bandwidth. Bytes are
+ * compulsory traffic (inputs read, output written once), without the extra
+ * read a cached store incurs.
+ */
+typedef struct {
+    double flops;                    // Floating-point operations per element
+    double bytes;                    // Bytes moved per element
+} hc_kernel_cost_t;
+
+typedef struct {
+    hc_kernel_t kernel;
+    hc_backend_t backend;
+    hc_kernel_cost_t cost;
+    double intensity;                // flop/byte
+    double gflops;                   // Achieved over the working set
+    double bound_gflops;             // min(peak, intensity * bandwidth)
+    double fraction;                 // gflops / bound_gflops
+    int memory_bound;                // Intensity below the ridge point
+} hc_roofline_point_t;
+
+typedef struct {
+    size_t working_set_bytes;
+    double peak_gflops;              // Single core, independent multiply-add chains
+    double bandwidth_gbs;            // Single core, a[i] = b[i] + s * c[i]
+    size_t count;
+    hc_roofline_point_t points[(int)HC_KERNEL_COUNT * (int)HC_BACKEND_COUNT];
+} hc_roofline_t;
+
+int hc_kernel_cost(hc_kernel_t kernel, hc_kernel_cost_t* cost);
+
+/**
+ * Measure peak, bandwidth and every available backend of every kernel over
+ * working_set_bytes; 0 picks max(64 MiB, 4x LLC) so the data comes from DRAM
+ */
+int hc_bench_roofline(const hc_bench_config_t* config, size_t working_set_bytes,
+                      hc_roofline_t* roofline);
+int hc_bench_print_roofline(FILE* out, const hc_roofline_t* roofline);
+int hc_bench_write_roofline_csv(FILE* out, const hc_roofline_t* roofline);
+
+/**
+ * Accuracy of one backend's kernel against a long double reference, in ULPs.
+ * Multiply is measured normwise (ULPs of |q1||q2|), since cancellation can
+ * leave a component arbitrarily small; the other kernels per component.
+ */
+typedef struct {
+    hc_kernel_t kernel;
+    hc_backend_t backend;
+    size_t samples;
+    double max_ulp[4];               // Per component w, x, y, z; norm uses [0] only
+    double mean_ulp[4];
+    double bound_ulp;                // Documented bound from hc_accuracy_bound
+    int within_bound;
+} hc_accuracy_result_t;
+
+/**
+ * Documented worst-case error of a kernel in ULPs for inputs whose
+ * components are zero or within 2^-60..2^60 in magnitude
+ */
+double hc_accuracy_bound(hc_kernel_t kernel);
+
+/**
+ * Run every available backend of every kernel on `samples` random and
+ * adversarial inputs; returns HC_ERROR_INVALID_DATA if any bound is exceeded
+ */
+int hc_accuracy_check(size_t samples, uint64_t seed, hc_accuracy_result_t* results,
+                      size_t capacity, size_t* count);
+int hc_accuracy_print(FILE* out, const hc_accuracy_result_t* results, size_t count);
+
+/**
+ * Work handed to the library's worker pool. The caller owns the task and keeps
+ * it alive until done has been called; the pool links queued tasks through
+ * next, so submitting never allocates. run and then done (if set) execute on a
+ * pool thread, and the pool does not touch the task once done is called.
+ */
+typedef struct hc_task hc_task_t;
+struct hc_task {
+    int (*run)(hc_task_t* task);
+    void (*done)(hc_task_t* task, int status);
+    void* context;
+    hc_task_t* next;
+};
+
+/**
+ * Queue a task. Up to the tuned thread count (at least one) pool threads serve
+ * the queue, oldest task first. HC_ERROR_NO_MEMORY, with the task not queued,
+ * when no pool thread could be started.
+ */
+int hc_task_submit(hc_task_t* task);
+
+/**
+ * Per-host tuning for the batch kernels and bulk encryption
+ */
+#define HC_MAX_THREADS 64
+
+typedef struct {
+    hc_backend_t batch_backend;      // Backend behind quaternion_*_batch (autovec or simd)
+    size_t chunk_elements;           // Quaternions per work item when a call is split across threads
+    unsigned threads;                // Threads per large call, counting the caller; 1 keeps calls inline
+    size_t nt_threshold_bytes;       // Non-temporal stores for batch outputs and ciphertexts at least
+                                     // this large; 0 = never. Builds without SIMD ignore it for batches.
+} hc_tuning_t;
+
+/**
+ * Setting or loading a tuning is safe while other threads make tuned calls.
+ * Each call copies the tuning once on entry, so it runs wholly under the old
+ * tuning or wholly under the new one.
+ */
+void hc_tuning_default(hc_tuning_t* tuning);
+int hc_tuning_get(hc_tuning_t* tuning);
+int hc_tuning_set(const hc_tuning_t* tuning);
+
+/**
+ * This host's tuning file: $HC_TUNING_FILE, else
+ * $XDG_CONFIG_HOME (or ~/.config)/hypercomplex/<hostname>.conf
+ */
+int hc_tuning_path(char* path, size_t size);
+
+/**
+ * Read or write a tuning file; NULL means hc_tuning_path. The host's file is
+ * loaded automatically before the first tuned call. Loading fails with
+ * HC_ERROR_INVALID_DATA, leaving the tuning unchanged, when the file is
+ * missing or names settings this build cannot use.
+ */
+int hc_tuning_load(const char* path);
+int hc_tuning_save(const char* path, const hc_tuning_t* tuning);
+
+/**
+ * Benchmark candidate backends, thread counts and chunk sizes on this host,
+ * apply the fastest combination and return it in best
+ */
+int hc_autotune(const hc_bench_config_t* config, hc_tuning_t* best);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * C++ interface (C++17): value-semantics quaternions whose arithmetic is
+ * constexpr and inlines, with arrays of hc::quaternion<float> handed to the
+ * batch kernels (and so the tuned SIMD backend) unchanged
+ */
+#ifdef __cplusplus
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HC_CXX_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#define HC_CXX_SSE 1
+#if defined(__AVX__)
+#include <immintrin.h>
+#define HC_CXX_AVX 1
+#endif
+#endif
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#include <vector>
+#define HC_HAVE_PMR 1
+#endif
+#if __has_include(<execution>)
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#if defined(__cpp_lib_execution)
+#define HC_HAVE_EXECUTION 1
+#endif
+#endif
+#if __has_include(<span>)
+#include <span>
+#if defined(__cpp_lib_span)
+#define HC_HAVE_SPAN 1
+#endif
+#endif
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <new>
+#define HC_HAVE_COROUTINES 1
+#endif
+#endif
+
+namespace hc {
+
+template <typename T>
+struct quaternion {
+    static_assert(std::is_floating_point<T>::value, "hc::quaternion needs a floating-point type");
+    
+    T w, x, y, z;
+    
+    constexpr quaternion() noexcept : w(0), x(0), y(0), z(0) {}
+    constexpr quaternion(T w_, T x_, T y_, T z_) noexcept : w(w_), x(x_), y(y_), z(z_) {}
+    constexpr quaternion(const quaternion_t& q) noexcept
+        : w(static_cast<T>(q.w)), x(static_cast<T>(q.x)), y(static_cast<T>(q.y)), z(static_cast<T>(q.z)) {}
+    
+    template <typename U>
+    constexpr explicit quaternion(const quaternion<U>& q) noexcept
+        : w(static_cast<T>(q.w)), x(static_cast<T>(q.x)), y(static_cast<T>(q.y)), z(static_cast<T>(q.z)) {}
+    
+    [[nodiscard]] static constexpr quaternion identity() noexcept { return quaternion(1, 0, 0, 0); }
+    
+    [[nodiscard]] constexpr quaternion_t c() const noexcept {
+        return quaternion_t{ static_cast<float>(w), static_cast<float>(x),
+                             static_cast<float>(y), static_cast<float>(z) };
+    }
+    
+    constexpr quaternion& operator+=(const quaternion& q) noexcept {
+        w += q.w; x += q.x; y += q.y; z += q.z;
+        return *this;
+    }
+    
+    constexpr quaternion& operator-=(const quaternion& q) noexcept {
+        w -= q.w; x -= q.x; y -= q.y; z -= q.z;
+        return *this;
+    }
+    
+    constexpr quaternion& operator*=(const quaternion& q) noexcept { return *this = *this * q; }
+    
+    constexpr quaternion& operator*=(T s) noexcept {
+        w *= s; x *= s; y *= s; z *= s;
+        return *this;
+    }
+    
+    // Hamilton product, same term order as the C kernels
+    [[nodiscard]] friend constexpr quaternion operator*(const quaternion& a, const quaternion& b) noexcept {
+        return quaternion(a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                          a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                          a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                          a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w);
+    }
+    
+    [[nodiscard]] friend constexpr quaternion operator+(quaternion a, const quaternion& b) noexcept { return a += b; }
+    [[nodiscard]] friend constexpr quaternion operator-(quaternion a, const quaternion& b) noexcept { return a -= b; }
+    [[nodiscard]] friend constexpr quaternion operator-(const quaternion& a) noexcept { return quaternion(-a.w, -a.x, -a.y, -a.z); }
+    [[nodiscard]] friend constexpr quaternion operator*(quaternion a, T s) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr quaternion operator*(T s, quaternion a) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr quaternion operator/(quaternion a, T s) noexcept { return a *= T(1) / s; }
+    
+    [[nodiscard]] friend constexpr bool operator==(const quaternion& a, const quaternion& b) noexcept {
+        return a.w == b.w && a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(const quaternion& a, const quaternion& b) noexcept { return !(a == b); }
+};
+
+using quaternionf = quaternion<float>;
+using quaterniond = quaternion<double>;
+
+// Arrays of quaternionf are passed straight to the C batch kernels
+static_assert(sizeof(quaternionf) == sizeof(quaternion_t) && std::is_standard_layout<quaternionf>::value,
+              "hc::quaternionf must stay layout-compatible with quaternion_t");
+
+template <typename T>
+[[nodiscard]] constexpr quaternion<T> conjugate(const quaternion<T>& q) noexcept {
+    return quaternion<T>(q.w, -q.x, -q.y, -q.z);
+}
+
+template <typename T>
+[[nodiscard]] constexpr T dot(const quaternion<T>& a, const quaternion<T>& b) noexcept {
+    return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template <typename T>
+[[nodiscard]] constexpr T norm_squared(const quaternion<T>& q) noexcept {
+    return dot(q, q);
+}
+
+template <typename T>
+[[nodiscard]] inline T norm(const quaternion<T>& q) noexcept {
+    return std::sqrt(norm_squared(q));
+}
+
+/**
+ * Unit quaternion in the same direction; like quaternion_normalize_batch,
+ * anything with norm below 1e-6 comes back unchanged
+ */
+template <typename T>
+[[nodiscard]] inline quaternion<T> normalized(const quaternion<T>& q) noexcept {
+    // Select the divisor rather than the result, so loops over this stay branch-free
+    T n = norm(q);
+    return q / (n < T(1e-6) ? T(1) : n);
+}
+
+/**
+ * Quaternion with norm 1, established once: from() normalizes and rejects
+ * zero, NaN and Inf; from_unit() trusts the caller. Products, inverses,
+ * rotations and slerp then use the unit-only formulas with no normalization.
+ * Builds without NDEBUG assert the norm on construction, within
+ * HC_UNIT_TOLERANCE, so a long product chain that drifts is caught there;
+ * renormalized() pulls it back.
+ */
+template <typename T>
+class unit_quaternion {
+public:
+    constexpr unit_quaternion() noexcept : q_(quaternion<T>::identity()) {}
+    
+    [[nodiscard]] static std::optional<unit_quaternion> from(const quaternion<T>& q) noexcept {
+        quaternion<T> s = q;
+        T n = norm(s);
+        
+        // Finite components can still overflow the norm; divide by the largest first
+        if (std::isinf(n)) {
+            s = q / std::fmax(std::fmax(std::fabs(q.w), std::fabs(q.x)), std::fmax(std::fabs(q.y), std::fabs(q.z)));
+            n = norm(s);
+        }
+        if (!(n >= T(1e-6)) || !std::isfinite(n)) return std::nullopt;    // NaN fails the first test
+        return unit_quaternion(s / n);
+    }
+    
+    [[nodiscard]] static constexpr unit_quaternion from_unit(const quaternion<T>& q) noexcept {
+        return unit_quaternion(q);
+    }
+    
+    // quaternion_generate_key, whose keys are always normalized
+    [[nodiscard]] static unit_quaternion key(uint64_t seed) noexcept {
+        quaternion_t k;
+        quaternion_generate_key(&k, seed);
+        return unit_quaternion(quaternion<T>(k));
+    }
+    
+    [[nodiscard]] constexpr const quaternion<T>& value() const noexcept { return q_; }
+    [[nodiscard]] constexpr quaternion_t c() const noexcept { return q_.c(); }
+    constexpr operator const quaternion<T>&() const noexcept { return q_; }
+    
+    [[nodiscard]] friend constexpr unit_quaternion operator*(const unit_quaternion& a, const unit_quaternion& b) noexcept {
+        return unit_quaternion(a.q_ * b.q_);
+    }
+    
+    [[nodiscard]] friend constexpr bool operator==(const unit_quaternion& a, const unit_quaternion& b) noexcept { return a.q_ == b.q_; }
+    [[nodiscard]] friend constexpr bool operator!=(const unit_quaternion& a, const unit_quaternion& b) noexcept { return a.q_ != b.q_; }
+    
+private:
+    constexpr explicit unit_quaternion(const quaternion<T>& q) noexcept : q_(q) {
+        assert(norm_squared(q) - T(1) <= T(HC_UNIT_TOLERANCE) && T(1) - norm_squared(q) <= T(HC_UNIT_TOLERANCE) &&
+               "hc::unit_quaternion needs norm 1");
+    }
+    
+    quaternion<T> q_;
+};
+
+using unit_quaternionf = unit_quaternion<float>;
+using unit_quaterniond = unit_quaternion<double>;
+
+template <typename T>
+[[nodiscard]] constexpr unit_quaternion<T> conjugate(const unit_quaternion<T>& q) noexcept {
+    return unit_quaternion<T>::from_unit(conjugate(q.value()));
+}
+
+// For a unit quaternion the inverse is the conjugate: no division
+template <typename T>
+[[nodiscard]] constexpr unit_quaternion<T> inverse(const unit_quaternion<T>& q) noexcept {
+    return conjugate(q);
+}
+
+/**
+ * q v q^-1 as v + w t + u x t with t = 2 (u x v), for the vector part u:
+ * 15 multiplies against 32 for the two Hamilton products
+ */
+template <typename T>
+[[nodiscard]] constexpr std::array<T, 3> rotate(const unit_quaternion<T>& q, const std::array<T, 3>& v) noexcept {
+    const quaternion<T>& u = q.value();
+    T tx = T(2) * (u.y * v[2] - u.z * v[1]);
+    T ty = T(2) * (u.z * v[0] - u.x * v[2]);
+    T tz = T(2) * (u.x * v[1] - u.y * v[0]);
+    
+    return { v[0] + u.w * tx + (u.y * tz - u.z * ty),
+             v[1] + u.w * ty + (u.z * tx - u.x * tz),
+             v[2] + u.w * tz + (u.x * ty - u.y * tx) };
+}
+
+/**
+ * Spherical interpolation along the shorter arc; t = 0 gives a, t = 1 gives b
+ * (or -b, the same rotation). Only nearly equal ends, where it falls back to
+ * a linear blend, renormalize.
+ */
+template <typename T>
+[[nodiscard]] inline unit_quaternion<T> slerp(const unit_quaternion<T>& a, const unit_quaternion<T>& b, T t) noexcept {
+    T d = dot(a.value(), b.value());
+    T sign = d < T(0) ? T(-1) : T(1);
+    d *= sign;
+    
+    if (d > T(0.9995)) {
+        quaternion<T> r = a.value() * (T(1) - t) + b.value() * (t * sign);
+        return unit_quaternion<T>::from_unit(r / norm(r));
+    }
+    
+    T theta = std::acos(d);
+    T inv_sin = T(1) / std::sin(theta);
+    return unit_quaternion<T>::from_unit(a.value() * (std::sin((T(1) - t) * theta) * inv_sin) +
+                                         b.value() * (std::sin(t * theta) * inv_sin * sign));
+}
+
+// One Newton step towards norm 1, q (3 - |q|^2) / 2; cheap enough to run every few products
+template <typename T>
+[[nodiscard]] constexpr unit_quaternion<T> renormalized(const unit_quaternion<T>& q) noexcept {
+    return unit_quaternion<T>::from_unit(q.value() * (T(0.5) * (T(3) - norm_squared(q.value()))));
+}
+
+/**
+ * Bulk operations on the library's tuned batch kernels; same status codes as C
+ */
+[[nodiscard]] inline int multiply(const quaternionf* a, const quaternionf* b, quaternionf* out, size_t count) noexcept {
+    return quaternion_multiply_batch(reinterpret_cast<const quaternion_t*>(a), reinterpret_cast<const quaternion_t*>(b),
+                                     reinterpret_cast<quaternion_t*>(out), count);
+}
+
+[[nodiscard]] inline int add(const quaternionf* a, const quaternionf* b, quaternionf* out, size_t count) noexcept {
+    return quaternion_add_batch(reinterpret_cast<const quaternion_t*>(a), reinterpret_cast<const quaternion_t*>(b),
+                                reinterpret_cast<quaternion_t*>(out), count);
+}
+
+[[nodiscard]] inline int conjugate(const quaternionf* in, quaternionf* out, size_t count) noexcept {
+    return quaternion_conjugate_batch(reinterpret_cast<const quaternion_t*>(in),
+                                      reinterpret_cast<quaternion_t*>(out), count);
+}
+
+[[nodiscard]] inline int normalize(const quaternionf* in, quaternionf* out, size_t count) noexcept {
+    return quaternion_normalize_batch(reinterpret_cast<const quaternion_t*>(in),
+                                      reinterpret_cast<quaternion_t*>(out), count);
+}
+
+/*
+ * Expression templates: array expressions such as normalize(a * b + c) build a
+ * tree at compile time and hc::evaluate runs it in one pass, element by
+ * element, with no temporary arrays. The loop body is the inlined scalar
+ * arithmetic above. Multiply, add, scale and conjugate trees vectorize at -O3;
+ * a normalize inside the tree takes sqrt, which GCC only vectorizes with
+ * -fno-math-errno, so a float normalize at the root goes to the batch kernel.
+ */
+template <typename E>
+struct array_expr {
+    constexpr const E& self() const noexcept { return static_cast<const E&>(*this); }
+};
+
+template <typename T>
+struct array_ref : array_expr<array_ref<T>> {
+    using value_type = quaternion<T>;
+    
+    const quaternion<T>* data;
+    size_t count;
+    
+    constexpr array_ref(const quaternion<T>* data_, size_t count_) noexcept : data(data_), count(count_) {}
+    constexpr quaternion<T> operator[](size_t i) const noexcept { return data[i]; }
+    constexpr bool fits(size_t n) const noexcept { return data && count == n; }
+};
+
+// One quaternion repeated for every element, e.g. a key
+template <typename T>
+struct broadcast_expr : array_expr<broadcast_expr<T>> {
+    using value_type = quaternion<T>;
+    
+    quaternion<T> value;
+    
+    constexpr explicit broadcast_expr(const quaternion<T>& value_) noexcept : value(value_) {}
+    constexpr quaternion<T> operator[](size_t) const noexcept { return value; }
+    constexpr bool fits(size_t) const noexcept { return true; }
+};
+
+template <typename Op, typename L, typename R>
+struct binary_expr : array_expr<binary_expr<Op, L, R>> {
+    using value_type = typename L::value_type;
+    static_assert(std::is_same<value_type, typename R::value_type>::value,
+                  "hc array expressions cannot mix float and double");
+    
+    L l;
+    R r;
+    
+    constexpr binary_expr(const L& l_, const R& r_) noexcept : l(l_), r(r_) {}
+    constexpr value_type operator[](size_t i) const noexcept { return Op::apply(l[i], r[i]); }
+    constexpr bool fits(size_t n) const noexcept { return l.fits(n) && r.fits(n); }
+};
+
+template <typename Op, typename E>
+struct unary_expr : array_expr<unary_expr<Op, E>> {
+    using value_type = typename E::value_type;
+    
+    E e;
+    
+    constexpr explicit unary_expr(const E& e_) noexcept : e(e_) {}
+    constexpr value_type operator[](size_t i) const noexcept { return Op::apply(e[i]); }
+    constexpr bool fits(size_t n) const noexcept { return e.fits(n); }
+};
+
+template <typename E>
+struct scale_expr : array_expr<scale_expr<E>> {
+    using value_type = typename E::value_type;
+    using scalar_type = decltype(value_type::w);
+    
+    E e;
+    scalar_type s;
+    
+    constexpr scale_expr(const E& e_, scalar_type s_) noexcept : e(e_), s(s_) {}
+    constexpr value_type operator[](size_t i) const noexcept { return e[i] * s; }
+    constexpr bool fits(size_t n) const noexcept { return e.fits(n); }
+};
+
+// Element operations; also usable as function objects, e.g. with std::transform
+namespace ops {
+template <typename Op>
+struct binary_fn {
+    template <typename Q> constexpr Q operator()(const Q& a, const Q& b) const noexcept { return Op::apply(a, b); }
+};
+template <typename Op>
+struct unary_fn {
+    template <typename Q> constexpr Q operator()(const Q& a) const noexcept { return Op::apply(a); }
+};
+
+struct add : binary_fn<add> { template <typename Q> static constexpr Q apply(const Q& a, const Q& b) noexcept { return a + b; } };
+struct subtract : binary_fn<subtract> { template <typename Q> static constexpr Q apply(const Q& a, const Q& b) noexcept { return a - b; } };
+struct multiply : binary_fn<multiply> { template <typename Q> static constexpr Q apply(const Q& a, const Q& b) noexcept { return a * b; } };
+struct negate : unary_fn<negate> { template <typename Q> static constexpr Q apply(const Q& a) noexcept { return -a; } };
+struct conjugate : unary_fn<conjugate> { template <typename Q> static constexpr Q apply(const Q& a) noexcept { return hc::conjugate(a); } };
+struct normalize : unary_fn<normalize> { template <typename Q> static Q apply(const Q& a) noexcept { return hc::normalized(a); } };
+} // namespace ops
+
+template <typename T>
+[[nodiscard]] constexpr array_ref<T> view(const quaternion<T>* data, size_t count) noexcept {
+    return array_ref<T>(data, count);
+}
+
+template <typename T>
+[[nodiscard]] constexpr broadcast_expr<T> broadcast(const quaternion<T>& value) noexcept {
+    return broadcast_expr<T>(value);
+}
+
+template <typename L, typename R>
+[[nodiscard]] constexpr binary_expr<ops::add, L, R> operator+(const array_expr<L>& l, const array_expr<R>& r) noexcept {
+    return binary_expr<ops::add, L, R>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+[[nodiscard]] constexpr binary_expr<ops::subtract, L, R> operator-(const array_expr<L>& l, const array_expr<R>& r) noexcept {
+    return binary_expr<ops::subtract, L, R>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+[[nodiscard]] constexpr binary_expr<ops::multiply, L, R> operator*(const array_expr<L>& l, const array_expr<R>& r) noexcept {
+    return binary_expr<ops::multiply, L, R>(l.self(), r.self());
+}
+
+template <typename E>
+[[nodiscard]] constexpr scale_expr<E> operator*(const array_expr<E>& e, typename scale_expr<E>::scalar_type s) noexcept {
+    return scale_expr<E>(e.self(), s);
+}
+
+template <typename E>
+[[nodiscard]] constexpr scale_expr<E> operator*(typename scale_expr<E>::scalar_type s, const array_expr<E>& e) noexcept {
+    return scale_expr<E>(e.self(), s);
+}
+
+template <typename E>
+[[nodiscard]] constexpr unary_expr<ops::negate, E> operator-(const array_expr<E>& e) noexcept {
+    return unary_expr<ops::negate, E>(e.self());
+}
+
+template <typename E>
+[[nodiscard]] constexpr unary_expr<ops::conjugate, E> conjugate(const array_expr<E>& e) noexcept {
+    return unary_expr<ops::conjugate, E>(e.self());
+}
+
+/**
+ * Elements with norm below 1e-6 pass through unchanged; unlike
+ * quaternion_normalize_batch, evaluate does not report them
+ */
+template <typename E>
+[[nodiscard]] constexpr unary_expr<ops::normalize, E> normalize(const array_expr<E>& e) noexcept {
+    return unary_expr<ops::normalize, E>(e.self());
+}
+
+namespace detail {
+
+// Output elements per block when evaluate hands a float normalize at the root
+// to the batch kernel: 16 KB, so the block is still in L1 for the second pass
+constexpr size_t evaluate_block = 1024;
+
+template <typename E>
+struct normalize_root : std::false_type {};
+
+template <typename E>
+struct normalize_root<unary_expr<ops::normalize, E>> : std::is_same<typename E::value_type, quaternionf> {};
+
+} // namespace detail
+
+/**
+ * Write count elements of an expression to out in a single pass. out may be
+ * one of the operands; HC_ERROR_INVALID_DATA if an operand's length differs.
+ * A float normalize(...) at the root runs its operand block by block and then
+ * normalizes each block in place with quaternion_normalize_batch.
+ */
+template <typename E>
+[[nodiscard]] int evaluate(typename E::value_type* out, size_t count, const array_expr<E>& expr) noexcept {
+    const E& e = expr.self();
+    
+    if (!out) return HC_ERROR_NULL_PTR;
+    if (!e.fits(count)) return HC_ERROR_INVALID_DATA;
+    
+    if constexpr (detail::normalize_root<E>::value) {
+        for (size_t i = 0; i < count; i += detail::evaluate_block) {
+            size_t n = count - i < detail::evaluate_block ? count - i : detail::evaluate_block;
+            for (size_t j = i; j < i + n; j++) {
+                out[j] = e.e[j];
+            }
+            
+            int status = normalize(out + i, out + i, n);
+            if (status != HC_SUCCESS && status != HC_ERROR_DIVIDE_ZERO) return status;
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = e[i];
+        }
+    }
+    
+    return HC_SUCCESS;
+}
+
+/*
+ * Fixed-size arrays: std::array<quaternion<T>, N>, and std::span with a static
+ * extent, unrolled completely at compile time with no loop or tail check.
+ * Float arrays go through SIMD registers in steps of eight quaternions (AVX)
+ * or four (SSE2, NEON), transposed like the SIMD backend, then narrower steps
+ * and single elements for the rest; the widths are fixed when the header is
+ * compiled. Arrays longer than HC_FIXED_UNROLL_MAX go to the batch kernels
+ * (float) or a plain loop.
+ */
+#ifndef HC_FIXED_UNROLL_MAX
+#define HC_FIXED_UNROLL_MAX 64
+#endif
+
+namespace detail {
+
+// Widest step, in quaternions, for element type T
+template <typename T>
+struct fixed_lanes : std::integral_constant<size_t, 1> {};
+
+#if defined(HC_CXX_AVX)
+template <>
+struct fixed_lanes<float> : std::integral_constant<size_t, 8> {};
+#elif defined(HC_CXX_NEON) || defined(HC_CXX_SSE)
+template <>
+struct fixed_lanes<float> : std::integral_constant<size_t, 4> {};
+#endif
+
+// W float quaternions at a time; unary operations ignore b
+template <typename Op, size_t W>
+struct fixed_step;
+
+#if defined(HC_CXX_NEON)
+
+template <>
+struct fixed_step<ops::multiply, 4> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        float32x4x4_t p = vld4q_f32(&a->w);
+        float32x4x4_t q = vld4q_f32(&b->w);
+        float32x4x4_t r;
+        
+        r.val[0] = vmulq_f32(p.val[0], q.val[0]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[1], q.val[1]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[2], q.val[2]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[3], q.val[3]);
+        
+        r.val[1] = vmulq_f32(p.val[0], q.val[1]);
+        r.val[1] = vfmaq_f32(r.val[1], p.val[1], q.val[0]);
+        r.val[1] = vfmaq_f32(r.val[1], p.val[2], q.val[3]);
+        r.val[1] = vfmsq_f32(r.val[1], p.val[3], q.val[2]);
+        
+        r.val[2] = vmulq_f32(p.val[0], q.val[2]);
+        r.val[2] = vfmsq_f32(r.val[2], p.val[1], q.val[3]);
+        r.val[2] = vfmaq_f32(r.val[2], p.val[2], q.val[0]);
+        r.val[2] = vfmaq_f32(r.val[2], p.val[3], q.val[1]);
+        
+        r.val[3] = vmulq_f32(p.val[0], q.val[3]);
+        r.val[3] = vfmaq_f32(r.val[3], p.val[1], q.val[2]);
+        r.val[3] = vfmsq_f32(r.val[3], p.val[2], q.val[1]);
+        r.val[3] = vfmaq_f32(r.val[3], p.val[3], q.val[0]);
+        
+        vst4q_f32(&out->w, r);
+    }
+};
+
+template <>
+struct fixed_step<ops::add, 4> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        // Plain vld1q per quaternion: the _x4 forms are missing from older GCC arm_neon.h
+        for (int k = 0; k < 4; k++) {
+            vst1q_f32(&out[k].w, vaddq_f32(vld1q_f32(&a[k].w), vld1q_f32(&b[k].w)));
+        }
+    }
+};
+
+template <>
+struct fixed_step<ops::conjugate, 4> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        float32x4x4_t p = vld4q_f32(&a->w);
+        p.val[1] = vnegq_f32(p.val[1]);
+        p.val[2] = vnegq_f32(p.val[2]);
+        p.val[3] = vnegq_f32(p.val[3]);
+        vst4q_f32(&out->w, p);
+    }
+};
+
+template <>
+struct fixed_step<ops::normalize, 4> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        float32x4x4_t p = vld4q_f32(&a->w);
+        float32x4_t sum = vmulq_f32(p.val[0], p.val[0]);
+        sum = vfmaq_f32(sum, p.val[1], p.val[1]);
+        sum = vfmaq_f32(sum, p.val[2], p.val[2]);
+        sum = vfmaq_f32(sum, p.val[3], p.val[3]);
+        
+        float32x4_t norm = vsqrtq_f32(sum);
+        uint32x4_t zero = vcltq_f32(norm, vdupq_n_f32(1e-6f));
+        float32x4_t divisor = vbslq_f32(zero, vdupq_n_f32(1.0f), norm);
+        for (int k = 0; k < 4; k++) p.val[k] = vdivq_f32(p.val[k], divisor);
+        vst4q_f32(&out->w, p);
+    }
+};
+
+#elif defined(HC_CXX_SSE)
+
+template <>
+struct fixed_step<ops::multiply, 4> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        __m128 aw = _mm_loadu_ps(&a[0].w), ax = _mm_loadu_ps(&a[1].w);
+        __m128 ay = _mm_loadu_ps(&a[2].w), az = _mm_loadu_ps(&a[3].w);
+        __m128 bw = _mm_loadu_ps(&b[0].w), bx = _mm_loadu_ps(&b[1].w);
+        __m128 by = _mm_loadu_ps(&b[2].w), bz = _mm_loadu_ps(&b[3].w);
+        _MM_TRANSPOSE4_PS(aw, ax, ay, az);
+        _MM_TRANSPOSE4_PS(bw, bx, by, bz);
+        
+        __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)),
+                                          _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        __m128 rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)),
+                                          _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)),
+                                          _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+        __m128 rz = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)),
+                                          _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+        
+        _MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+        _mm_storeu_ps(&out[0].w, rw);
+        _mm_storeu_ps(&out[1].w, rx);
+        _mm_storeu_ps(&out[2].w, ry);
+        _mm_storeu_ps(&out[3].w, rz);
+    }
+};
+
+template <>
+struct fixed_step<ops::add, 4> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        for (int k = 0; k < 4; k++) {
+            _mm_storeu_ps(&out[k].w, _mm_add_ps(_mm_loadu_ps(&a[k].w), _mm_loadu_ps(&b[k].w)));
+        }
+    }
+};
+
+template <>
+struct fixed_step<ops::conjugate, 4> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        __m128 mask = _mm_set_ps(-0.0f, -0.0f, -0.0f, 0.0f);
+        for (int k = 0; k < 4; k++) {
+            _mm_storeu_ps(&out[k].w, _mm_xor_ps(_mm_loadu_ps(&a[k].w), mask));
+        }
+    }
+};
+
+template <>
+struct fixed_step<ops::normalize, 4> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        __m128 w = _mm_loadu_ps(&a[0].w), x = _mm_loadu_ps(&a[1].w);
+        __m128 y = _mm_loadu_ps(&a[2].w), z = _mm_loadu_ps(&a[3].w);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        
+        __m128 norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+                                             _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z))));
+        __m128 zero = _mm_cmplt_ps(norm, _mm_set1_ps(1e-6f));
+        __m128 divisor = _mm_or_ps(_mm_and_ps(zero, _mm_set1_ps(1.0f)), _mm_andnot_ps(zero, norm));
+        
+        w = _mm_div_ps(w, divisor);
+        x = _mm_div_ps(x, divisor);
+        y = _mm_div_ps(y, divisor);
+        z = _mm_div_ps(z, divisor);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        _mm_storeu_ps(&out[0].w, w);
+        _mm_storeu_ps(&out[1].w, x);
+        _mm_storeu_ps(&out[2].w, y);
+        _mm_storeu_ps(&out[3].w, z);
+    }
+};
+
+#endif /* HC_CXX_NEON / HC_CXX_SSE */
+
+#if defined(HC_CXX_AVX)
+
+// Quaternions k and k + 4 share a register, so the in-lane 4x4 transpose
+// leaves components 0-3 in the low half and 4-7 in the high half
+inline void fixed_load8(const quaternionf* q, __m256 r[4]) noexcept {
+    for (int k = 0; k < 4; k++) {
+        r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&q[k].w)), _mm_loadu_ps(&q[k + 4].w), 1);
+    }
+}
+
+inline void fixed_store8(quaternionf* q, const __m256 r[4]) noexcept {
+    for (int k = 0; k < 4; k++) {
+        _mm_storeu_ps(&q[k].w, _mm256_castps256_ps128(r[k]));
+        _mm_storeu_ps(&q[k + 4].w, _mm256_extractf128_ps(r[k], 1));
+    }
+}
+
+inline void fixed_transpose8(__m256 r[4]) noexcept {
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpacklo_ps(r[2], r[3]);
+    __m256 t2 = _mm256_unpackhi_ps(r[0], r[1]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    r[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    r[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    r[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+template <>
+struct fixed_step<ops::multiply, 8> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        __m256 p[4], q[4], r[4];
+        fixed_load8(a, p);
+        fixed_load8(b, q);
+        fixed_transpose8(p);
+        fixed_transpose8(q);
+        
+        r[0] = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(p[0], q[0]), _mm256_mul_ps(p[1], q[1])),
+                                           _mm256_mul_ps(p[2], q[2])), _mm256_mul_ps(p[3], q[3]));
+        r[1] = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p[0], q[1]), _mm256_mul_ps(p[1], q[0])),
+                                           _mm256_mul_ps(p[2], q[3])), _mm256_mul_ps(p[3], q[2]));
+        r[2] = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(p[0], q[2]), _mm256_mul_ps(p[1], q[3])),
+                                           _mm256_mul_ps(p[2], q[0])), _mm256_mul_ps(p[3], q[1]));
+        r[3] = _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(p[0], q[3]), _mm256_mul_ps(p[1], q[2])),
+                                           _mm256_mul_ps(p[2], q[1])), _mm256_mul_ps(p[3], q[0]));
+        
+        fixed_transpose8(r);
+        fixed_store8(out, r);
+    }
+};
+
+template <>
+struct fixed_step<ops::add, 8> {
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out) noexcept {
+        for (int k = 0; k < 8; k += 2) {
+            _mm256_storeu_ps(&out[k].w, _mm256_add_ps(_mm256_loadu_ps(&a[k].w), _mm256_loadu_ps(&b[k].w)));
+        }
+    }
+};
+
+template <>
+struct fixed_step<ops::conjugate, 8> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        __m256 mask = _mm256_set_ps(-0.0f, -0.0f, -0.0f, 0.0f, -0.0f, -0.0f, -0.0f, 0.0f);
+        for (int k = 0; k < 8; k += 2) {
+            _mm256_storeu_ps(&out[k].w, _mm256_xor_ps(_mm256_loadu_ps(&a[k].w), mask));
+        }
+    }
+};
+
+template <>
+struct fixed_step<ops::normalize, 8> {
+    static void run(const quaternionf* a, const quaternionf*, quaternionf* out) noexcept {
+        __m256 p[4];
+        fixed_load8(a, p);
+        fixed_transpose8(p);
+        
+        __m256 norm = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p[0], p[0]), _mm256_mul_ps(p[1], p[1])),
+                                                   _mm256_add_ps(_mm256_mul_ps(p[2], p[2]), _mm256_mul_ps(p[3], p[3]))));
+        __m256 zero = _mm256_cmp_ps(norm, _mm256_set1_ps(1e-6f), _CMP_LT_OQ);
+        __m256 divisor = _mm256_blendv_ps(norm, _mm256_set1_ps(1.0f), zero);
+        for (int k = 0; k < 4; k++) p[k] = _mm256_div_ps(p[k], divisor);
+        
+        fixed_transpose8(p);
+        fixed_store8(out, p);
+    }
+};
+
+#endif /* HC_CXX_AVX */
+
+template <typename Op, typename T>
+constexpr void fixed_element(const quaternion<T>* a, const quaternion<T>* b, quaternion<T>* out, size_t i) noexcept {
+    if constexpr (std::is_base_of<ops::binary_fn<Op>, Op>::value) {
+        out[i] = Op::apply(a[i], b[i]);
+    } else {
+        out[i] = Op::apply(a[i]);
+    }
+}
+
+inline void fixed_batch(ops::multiply, const quaternionf* a, const quaternionf* b, quaternionf* out, size_t n) noexcept {
+    (void)hc::multiply(a, b, out, n);
+}
+inline void fixed_batch(ops::add, const quaternionf* a, const quaternionf* b, quaternionf* out, size_t n) noexcept {
+    (void)hc::add(a, b, out, n);
+}
+inline void fixed_batch(ops::conjugate, const quaternionf* a, const quaternionf*, quaternionf* out, size_t n) noexcept {
+    (void)hc::conjugate(a, out, n);
+}
+inline void fixed_batch(ops::normalize, const quaternionf* a, const quaternionf*, quaternionf* out, size_t n) noexcept {
+    (void)hc::normalize(a, out, n);    // Zero elements stay zero, as with ops::normalize
+}
+
+template <typename Op, size_t W, typename T, size_t... G>
+constexpr void fixed_steps(const quaternion<T>* a, const quaternion<T>* b, quaternion<T>* out,
+                           std::index_sequence<G...>) noexcept {
+    if constexpr (W == 1) {
+        (fixed_element<Op>(a, b, out, G), ...);
+    } else {
+        (fixed_step<Op, W>::run(a + G * W, b + G * W, out + G * W), ...);
+    }
+}
+
+// Steps of W, then the remaining N % W elements with the next narrower width
+template <typename Op, size_t N, size_t W, typename T>
+constexpr void fixed_unrolled(const quaternion<T>* a, const quaternion<T>* b, quaternion<T>* out) noexcept {
+    constexpr size_t done = N / W * W;
+    
+    fixed_steps<Op, W>(a, b, out, std::make_index_sequence<N / W>{});
+    if constexpr (W > 1 && done < N) {
+        fixed_unrolled<Op, N - done, (W > 4 ? 4 : 1)>(a + done, b + done, out + done);
+    }
+}
+
+// out may be a or b; every element is read before it is written. Intrinsics
+// and the batch kernels cannot run in a constant expression, so constant
+// evaluation takes the element loop (C++20; in C++17 only doubles fold)
+template <typename Op, size_t N, typename T>
+constexpr void fixed_apply(const quaternion<T>* a, const quaternion<T>* b, quaternion<T>* out) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < N; i++) fixed_element<Op>(a, b, out, i);
+        return;
+    }
+#endif
+    if constexpr (N > HC_FIXED_UNROLL_MAX && std::is_same<T, float>::value) {
+        fixed_batch(Op{}, a, b, out, N);
+    } else if constexpr (N > HC_FIXED_UNROLL_MAX) {
+        for (size_t i = 0; i < N; i++) fixed_element<Op>(a, b, out, i);
+    } else {
+        fixed_unrolled<Op, N, fixed_lanes<T>::value>(a, b, out);
+    }
+}
+
+} // namespace detail
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr std::array<quaternion<T>, N> multiply(const std::array<quaternion<T>, N>& a,
+                                                              const std::array<quaternion<T>, N>& b) noexcept {
+    std::array<quaternion<T>, N> out{};
+    detail::fixed_apply<ops::multiply, N>(a.data(), b.data(), out.data());
+    return out;
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr std::array<quaternion<T>, N> add(const std::array<quaternion<T>, N>& a,
+                                                         const std::array<quaternion<T>, N>& b) noexcept {
+    std::array<quaternion<T>, N> out{};
+    detail::fixed_apply<ops::add, N>(a.data(), b.data(), out.data());
+    return out;
+}
+
+template <typename T, size_t N>
+[[nodiscard]] constexpr std::array<quaternion<T>, N> conjugate(const std::array<quaternion<T>, N>& a) noexcept {
+    std::array<quaternion<T>, N> out{};
+    detail::fixed_apply<ops::conjugate, N>(a.data(), a.data(), out.data());
+    return out;
+}
+
+/**
+ * Elements with norm below 1e-6 pass through unchanged, as with hc::normalized
+ */
+template <typename T, size_t N>
+[[nodiscard]] std::array<quaternion<T>, N> normalize(const std::array<quaternion<T>, N>& a) noexcept {
+    std::array<quaternion<T>, N> out;
+    detail::fixed_apply<ops::normalize, N>(a.data(), a.data(), out.data());
+    return out;
+}
+
+#ifdef HC_HAVE_SPAN
+/*
+ * The same kernels on std::span with a static extent, writing to out; out may
+ * be one of the inputs. A, B are quaternion<T> or const quaternion<T>.
+ */
+namespace detail {
+template <typename A, typename T, size_t N>
+constexpr bool fixed_span_v = N != std::dynamic_extent && std::is_same<std::remove_const_t<A>, quaternion<T>>::value;
+} // namespace detail
+
+template <typename A, typename B, typename T, size_t N>
+    requires detail::fixed_span_v<A, T, N> && detail::fixed_span_v<B, T, N>
+constexpr void multiply(std::span<A, N> a, std::span<B, N> b, std::span<quaternion<T>, N> out) noexcept {
+    detail::fixed_apply<ops::multiply, N, T>(a.data(), b.data(), out.data());
+}
+
+template <typename A, typename B, typename T, size_t N>
+    requires detail::fixed_span_v<A, T, N> && detail::fixed_span_v<B, T, N>
+constexpr void add(std::span<A, N> a, std::span<B, N> b, std::span<quaternion<T>, N> out) noexcept {
+    detail::fixed_apply<ops::add, N, T>(a.data(), b.data(), out.data());
+}
+
+template <typename A, typename T, size_t N>
+    requires detail::fixed_span_v<A, T, N>
+constexpr void conjugate(std::span<A, N> a, std::span<quaternion<T>, N> out) noexcept {
+    detail::fixed_apply<ops::conjugate, N, T>(a.data(), a.data(), out.data());
+}
+
+template <typename A, typename T, size_t N>
+    requires detail::fixed_span_v<A, T, N>
+void normalize(std::span<A, N> a, std::span<quaternion<T>, N> out) noexcept {
+    detail::fixed_apply<ops::normalize, N, T>(a.data(), a.data(), out.data());
+}
+#endif /* HC_HAVE_SPAN */
+
+#ifdef HC_HAVE_EXECUTION
+/*
+ * Parallel algorithms: hc::transform and hc::reduce take a standard execution
+ * policy. For contiguous quaternionf ranges with one of the ops function
+ * objects, any policy but seq runs the library's tuned SIMD kernels and worker
+ * pool; everything else goes to the standard algorithm with the same policy.
+ */
+
+namespace detail {
+
+template <typename Policy>
+inline constexpr bool library_policy_v =
+    !std::is_same_v<std::decay_t<Policy>, std::execution::sequenced_policy>;
+
+template <typename It, typename = void>
+struct quaternionf_range : std::false_type {};
+
+template <typename T>
+struct quaternionf_range<T*> : std::is_same<std::remove_cv_t<T>, quaternionf> {};
+
+#if defined(__cpp_lib_concepts) && defined(__cpp_lib_to_address)
+template <typename It>
+struct quaternionf_range<It, std::enable_if_t<!std::is_pointer_v<It> && std::contiguous_iterator<It>>>
+    : std::is_same<std::iter_value_t<It>, quaternionf> {};
+#endif
+
+template <typename It>
+inline constexpr bool quaternionf_range_v = quaternionf_range<It>::value;
+
+template <typename It>
+[[nodiscard]] constexpr auto address(It it) noexcept {
+    if constexpr (std::is_pointer_v<It>) {
+        return it;
+    } else {
+#if defined(__cpp_lib_to_address)
+        return std::to_address(it);
+#endif
+    }
+}
+
+// The batch call behind each function object; arity 0 means there is none
+template <typename Op> struct batch_kernel { static constexpr int arity = 0; };
+
+template <> struct batch_kernel<ops::multiply> {
+    static constexpr int arity = 2;
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out, size_t n) noexcept {
+        (void)hc::multiply(a, b, out, n);
+    }
+};
+
+template <> struct batch_kernel<ops::add> {
+    static constexpr int arity = 2;
+    static void run(const quaternionf* a, const quaternionf* b, quaternionf* out, size_t n) noexcept {
+        (void)hc::add(a, b, out, n);
+    }
+};
+
+template <> struct batch_kernel<ops::conjugate> {
+    static constexpr int arity = 1;
+    static void run(const quaternionf* in, quaternionf* out, size_t n) noexcept {
+        (void)hc::conjugate(in, out, n);
+    }
+};
+
+// Near-zero elements pass through unchanged, as ops::normalize does; their status is dropped
+template <> struct batch_kernel<ops::normalize> {
+    static constexpr int arity = 1;
+    static void run(const quaternionf* in, quaternionf* out, size_t n) noexcept {
+        (void)hc::normalize(in, out, n);
+    }
+};
+
+} // namespace detail
+
+template <typename Policy, typename InIt, typename OutIt, typename Op,
+          std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+OutIt transform(Policy&& policy, InIt first, InIt last, OutIt out, Op op) {
+    if constexpr (detail::library_policy_v<Policy> && detail::batch_kernel<Op>::arity == 1 &&
+                  detail::quaternionf_range_v<InIt> && detail::quaternionf_range_v<OutIt>) {
+        size_t count = static_cast<size_t>(last - first);
+        if (count) detail::batch_kernel<Op>::run(detail::address(first), detail::address(out), count);
+        return out + count;
+    } else {
+        return std::transform(std::forward<Policy>(policy), first, last, out, op);
+    }
+}
+
+template <typename Policy, typename InIt1, typename InIt2, typename OutIt, typename Op,
+          std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+OutIt transform(Policy&& policy, InIt1 first1, InIt1 last1, InIt2 first2, OutIt out, Op op) {
+    if constexpr (detail::library_policy_v<Policy> && detail::batch_kernel<Op>::arity == 2 &&
+                  detail::quaternionf_range_v<InIt1> && detail::quaternionf_range_v<InIt2> &&
+                  detail::quaternionf_range_v<OutIt>) {
+        size_t count = static_cast<size_t>(last1 - first1);
+        if (count) {
+            detail::batch_kernel<Op>::run(detail::address(first1), detail::address(first2),
+                                          detail::address(out), count);
+        }
+        return out + count;
+    } else {
+        return std::transform(std::forward<Policy>(policy), first1, last1, first2, out, op);
+    }
+}
+
+/**
+ * With ops::add this is quaternion_sum; with ops::multiply it is
+ * quaternion_product, which keeps the order of the non-commutative product
+ * where std::reduce would not
+ */
+template <typename Policy, typename It, typename T, typename Op,
+          std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+T reduce(Policy&& policy, It first, It last, T init, Op op) {
+    constexpr bool sum = std::is_same_v<Op, ops::add>;
+    constexpr bool product = std::is_same_v<Op, ops::multiply>;
+    
+    if constexpr (detail::library_policy_v<Policy> && (sum || product) &&
+                  std::is_same_v<T, quaternionf> && detail::quaternionf_range_v<It>) {
+        size_t count = static_cast<size_t>(last - first);
+        quaternion_t r = product ? quaternion_t{ 1.0f, 0.0f, 0.0f, 0.0f } : quaternion_t{ 0.0f, 0.0f, 0.0f, 0.0f };
+        const quaternion_t* q = count ? reinterpret_cast<const quaternion_t*>(detail::address(first)) : nullptr;
+        
+        if constexpr (product) {
+            (void)quaternion_product(q, count, &r);
+            return init * quaternionf(r);
+        } else {
+            (void)quaternion_sum(q, count, &r);
+            return init + quaternionf(r);
+        }
+    } else {
+        return std::reduce(std::forward<Policy>(policy), first, last, init, op);
+    }
+}
+
+// Sum of the range
+template <typename Policy, typename It,
+          std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+typename std::iterator_traits<It>::value_type reduce(Policy&& policy, It first, It last) {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    return hc::reduce(std::forward<Policy>(policy), first, last, value_type(), ops::add{});
+}
+
+#endif /* HC_HAVE_EXECUTION */
+
+#ifdef HC_HAVE_PMR
+/*
+ * Containers on std::pmr, and a per-frame arena to put them in
+ */
+
+/**
+ * Bump allocator that hands out 64-byte-aligned blocks and frees nothing until
+ * reset() or release(). Not thread-safe; use one per thread or per frame.
+ */
+class arena_resource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t alignment = 64;
+    
+    explicit arena_resource(size_t initial_bytes = size_t(1) << 20,
+                            std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : upstream_(upstream), next_size_(initial_bytes < 4096 ? 4096 : initial_bytes) {}
+    ~arena_resource() override { release(); }
+    
+    arena_resource(const arena_resource&) = delete;
+    arena_resource& operator=(const arena_resource&) = delete;
+    
+    /**
+     * Start a new frame; everything handed out so far becomes invalid. Chunks
+     * added during the frame are merged into one, so a steady frame loop stops
+     * calling the upstream resource after its first frame.
+     */
+    void reset() {
+        if (chunks_ && chunks_->next) {
+            size_t total = capacity();
+            release();
+            next_size_ = total;
+            grow(0);
+        } else if (chunks_) {
+            cursor_ = reinterpret_cast<char*>(chunks_) + header;
+        }
+    }
+    
+    // Return every chunk to the upstream resource
+    void release() noexcept {
+        while (chunks_) {
+            chunk* c = chunks_;
+            chunks_ = c->next;
+            upstream_->deallocate(c, c->size, alignment);
+        }
+        cursor_ = end_ = nullptr;
+    }
+    
+    [[nodiscard]] size_t capacity() const noexcept {
+        size_t total = 0;
+        for (const chunk* c = chunks_; c; c = c->next) total += c->size;
+        return total;
+    }
+    
+private:
+    struct chunk {
+        chunk* next;
+        size_t size;
+    };
+    static constexpr size_t header = alignment;      // Keeps the first block of a chunk aligned
+    
+    std::pmr::memory_resource* upstream_;
+    size_t next_size_;
+    chunk* chunks_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    
+    void grow(size_t min_bytes) {
+        size_t size = next_size_;
+        while (size < min_bytes + header) size *= 2;
+        
+        chunk* c = static_cast<chunk*>(upstream_->allocate(size, alignment));
+        c->next = chunks_;
+        c->size = size;
+        chunks_ = c;
+        cursor_ = reinterpret_cast<char*>(c) + header;
+        end_ = reinterpret_cast<char*>(c) + size;
+        next_size_ = size * 2;
+    }
+    
+    static std::uintptr_t align_up(const char* p, size_t align) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(p) + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+    }
+    
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align < alignment) align = alignment;
+        
+        std::uintptr_t p = align_up(cursor_, align);
+        if (!cursor_ || p + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+            grow(bytes + align);
+            p = align_up(cursor_, align);
+        }
+        
+        cursor_ = reinterpret_cast<char*>(p + bytes);
+        return reinterpret_cast<void*>(p);
+    }
+    
+    void do_deallocate(void*, size_t, size_t) noexcept override {}
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * Array of quaternions; on an arena_resource its data is 64-byte aligned
+ */
+template <typename T = float>
+using quat_vector = std::pmr::vector<quaternion<T>>;
+
+/**
+ * Structure-of-arrays quaternions: one array per component, so component-wise
+ * loops vectorize without shuffles
+ */
+template <typename T = float>
+class quat_soa_vector {
+public:
+    using value_type = quaternion<T>;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    
+    explicit quat_soa_vector(allocator_type alloc = {}) : w_(alloc), x_(alloc), y_(alloc), z_(alloc) {}
+    explicit quat_soa_vector(size_t count, allocator_type alloc = {})
+        : w_(count, alloc), x_(count, alloc), y_(count, alloc), z_(count, alloc) {}
+    
+    [[nodiscard]] size_t size() const noexcept { return w_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return w_.empty(); }
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return w_.get_allocator(); }
+    
+    void reserve(size_t count) { w_.reserve(count); x_.reserve(count); y_.reserve(count); z_.reserve(count); }
+    void resize(size_t count) { w_.resize(count); x_.resize(count); y_.resize(count); z_.resize(count); }
+    void clear() noexcept { w_.clear(); x_.clear(); y_.clear(); z_.clear(); }
+    
+    void push_back(const quaternion<T>& q) {
+        w_.push_back(q.w); x_.push_back(q.x); y_.push_back(q.y); z_.push_back(q.z);
+    }
+    
+    [[nodiscard]] quaternion<T> operator[](size_t i) const noexcept { return quaternion<T>(w_[i], x_[i], y_[i], z_[i]); }
+    
+    void set(size_t i, const quaternion<T>& q) noexcept {
+        w_[i] = q.w; x_[i] = q.x; y_[i] = q.y; z_[i] = q.z;
+    }
+    
+    T* w() noexcept { return w_.data(); }
+    T* x() noexcept { return x_.data(); }
+    T* y() noexcept { return y_.data(); }
+    T* z() noexcept { return z_.data(); }
+    const T* w() const noexcept { return w_.data(); }
+    const T* x() const noexcept { return x_.data(); }
+    const T* y() const noexcept { return y_.data(); }
+    const T* z() const noexcept { return z_.data(); }
+    
+    // Convert from and to interleaved arrays
+    void assign(const quaternion<T>* in, size_t count) {
+        resize(count);
+        for (size_t i = 0; i < count; i++) set(i, in[i]);
+    }
+    
+    void copy_to(quaternion<T>* out) const noexcept {
+        for (size_t i = 0; i < size(); i++) out[i] = (*this)[i];
+    }
+    
+private:
+    std::pmr::vector<T> w_, x_, y_, z_;
+};
+
+/**
+ * Hamilton product of two SoA arrays, resizing out; out may alias an input
+ */
+template <typename T>
+[[nodiscard]] int multiply(const quat_soa_vector<T>& a, const quat_soa_vector<T>& b, quat_soa_vector<T>& out) {
+    if (a.size() != b.size()) return HC_ERROR_INVALID_DATA;
+    out.resize(a.size());
+    
+    const T *aw = a.w(), *ax = a.x(), *ay = a.y(), *az = a.z();
+    const T *bw = b.w(), *bx = b.x(), *by = b.y(), *bz = b.z();
+    T *ow = out.w(), *ox = out.x(), *oy = out.y(), *oz = out.z();
+    
+    for (size_t i = 0; i < a.size(); i++) {
+        T w = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+        T x = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+        T y = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+        T z = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+        ow[i] = w; ox[i] = x; oy[i] = y; oz[i] = z;
+    }
+    
+    return HC_SUCCESS;
+}
+#endif /* HC_HAVE_PMR */
+
+#ifdef HC_HAVE_COROUTINES
+/*
+ * Coroutines (C++20): encryption awaited on the library's worker pool
+ */
+
+/**
+ * Base for promise types whose coroutine frames come from the size-classed
+ * buffer pool (hc_buffer_acquire), so a steady stream of coroutine calls
+ * stops reaching malloc. Frames may be freed on any thread.
+ */
+struct pooled_frame {
+    static void* operator new(size_t size) {
+        void* frame = hc_buffer_acquire(size);
+        if (!frame) throw std::bad_alloc();
+        return frame;
+    }
+    static void operator delete(void* frame) noexcept { hc_buffer_release(frame); }
+};
+
+/**
+ * Result of encrypt_async: co_await yields the hypercomplex_encrypt_data
+ * status. The awaiting coroutine is resumed on the pool thread that did the
+ * work; the task lives inside the awaitable, in the coroutine's own frame, so
+ * nothing is allocated per call. Arguments must outlive the co_await.
+ */
+class encrypt_awaitable {
+public:
+    encrypt_awaitable(const void* plaintext, size_t length, const quaternion_t& key,
+                      void* ciphertext, size_t* cipher_length) noexcept
+        : plaintext_(plaintext), length_(length), key_(key),
+          ciphertext_(ciphertext), cipher_length_(cipher_length) {}
+    
+    encrypt_awaitable(const encrypt_awaitable&) = delete;
+    encrypt_awaitable& operator=(const encrypt_awaitable&) = delete;
+    
+    bool await_ready() const noexcept { return false; }
+    
+    // Without a pool thread the work runs here and the coroutine never suspends
+    bool await_suspend(std::coroutine_handle<> waiter) noexcept {
+        waiter_ = waiter;
+        task_ = hc_task_t{ &run, &done, this, nullptr };
+        if (hc_task_submit(&task_) == HC_SUCCESS) return true;
+        
+        status_ = run(&task_);
+        return false;
+    }
+    
+    int await_resume() const noexcept { return status_; }
+    
+private:
+    static int run(hc_task_t* task) noexcept {
+        auto* self = static_cast<encrypt_awaitable*>(task->context);
+        return hypercomplex_encrypt_data(self->plaintext_, self->length_, &self->key_,
+                                         self->ciphertext_, self->cipher_length_);
+    }
+    
+    static void done(hc_task_t* task, int status) noexcept {
+        auto* self = static_cast<encrypt_awaitable*>(task->context);
+        self->status_ = status;
+        self->waiter_.resume();
+    }
+    
+    const void* plaintext_;
+    size_t length_;
+    quaternion_t key_;
+    void* ciphertext_;
+    size_t* cipher_length_;
+    hc_task_t task_{};
+    std::coroutine_handle<> waiter_;
+    int status_ = HC_SUCCESS;
+};
+
+inline encrypt_awaitable encrypt_async(const void* plaintext, size_t length, const quaternion_t& key,
+                                       void* ciphertext, size_t* cipher_length) noexcept {
+    return encrypt_awaitable(plaintext, length, key, ciphertext, cipher_length);
+}
+
+/**
+ * Lazily started asynchronous sequence: `while (auto* v = co_await gen.next())`.
+ * Each value stays valid until the next co_await on the generator; the
+ * consumer resumes on whichever thread the generator last ran on.
+ * Exceptions thrown by the generator are rethrown from next().
+ */
+template <typename T>
+class async_generator {
+public:
+    struct promise_type;
+    using handle = std::coroutine_handle<promise_type>;
+    
+    // Hands control straight back to the consumer waiting in next()
+    struct yield_awaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(handle h) noexcept { return h.promise().consumer; }
+        void await_resume() const noexcept {}
+    };
+    
+    struct promise_type : pooled_frame {
+        const T* value = nullptr;
+        std::coroutine_handle<> consumer;
+        std::exception_ptr error;
+        
+        async_generator get_return_object() noexcept { return async_generator(handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        yield_awaiter final_suspend() noexcept {
+            value = nullptr;
+            return {};
+        }
+        yield_awaiter yield_value(const T& v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+    
+    struct next_awaiter {
+        handle gen;
+        
+        bool await_ready() const noexcept { return !gen || gen.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+            gen.promise().consumer = consumer;
+            return gen;
+        }
+        const T* await_resume() const {
+            if (!gen) return nullptr;
+            if (gen.promise().error) std::rethrow_exception(gen.promise().error);
+            return gen.done() ? nullptr : gen.promise().value;
+        }
+    };
+    
+    async_generator(async_generator&& other) noexcept : gen_(other.gen_) { other.gen_ = nullptr; }
+    async_generator& operator=(async_generator&& other) noexcept {
+        if (this != &other) {
+            if (gen_) gen_.destroy();
+            gen_ = other.gen_;
+            other.gen_ = nullptr;
+        }
+        return *this;
+    }
+    ~async_generator() {
+        if (gen_) gen_.destroy();
+    }
+    
+    // The next value, or nullptr once the generator has finished
+    next_awaiter next() noexcept { return next_awaiter{ gen_ }; }
+    
+private:
+    explicit async_generator(handle gen) noexcept : gen_(gen) {}
+    
+    handle gen_;
+};
+
+/**
+ * One piece of an encrypt_chunks stream: a full ciphertext, header included,
+ * for plaintext [offset, offset + chunk_bytes). hypercomplex_decrypt_data
+ * takes it on its own and returns that piece of plaintext exactly.
+ */
+struct encrypted_chunk {
+    const void* data;
+    size_t size;
+    size_t offset;
+    int status;                       // HC_SUCCESS, or the error that ends the stream
+};
+
+/**
+ * Encrypt plaintext chunk by chunk on the worker pool, yielding each
+ * ciphertext as it completes. Ciphertext buffers come from the buffer pool and
+ * are recycled once the consumer asks for the next chunk. plaintext must stay
+ * valid while the generator runs.
+ */
+inline async_generator<encrypted_chunk> encrypt_chunks(const void* plaintext, size_t length,
+                                                       quaternion_t key, size_t chunk_bytes) {
+    struct buffer_release {
+        void operator()(void* buffer) const noexcept { hc_buffer_release(buffer); }
+    };
+    const auto* bytes = static_cast<const uint8_t*>(plaintext);
+    if (chunk_bytes == 0) chunk_bytes = length;
+    
+    for (size_t offset = 0; offset < length; offset += chunk_bytes) {
+        size_t n = length - offset < chunk_bytes ? length - offset : chunk_bytes;
+        size_t size = hypercomplex_cipher_length(n);
+        std::unique_ptr<void, buffer_release> buffer(hc_buffer_acquire(size));
+        int status = HC_ERROR_NO_MEMORY;
+        
+        if (buffer) status = co_await encrypt_async(bytes + offset, n, key, buffer.get(), &size);
+        co_yield encrypted_chunk{ buffer.get(), size, offset, status };
+        if (status != HC_SUCCESS) co_return;
+    }
+}
+
+#endif /* HC_HAVE_COROUTINES */
+
+// i * j = k, evaluated by the compiler
+static_assert(quaternionf(0, 1, 0, 0) * quaternionf(0, 0, 1, 0) == quaternionf(0, 0, 0, 1),
+              "Hamilton product must fold at compile time");
+static_assert(multiply(std::array<quaterniond, 2>{ quaterniond(0, 1, 0, 0), quaterniond(0, 0, 1, 0) },
+                       std::array<quaterniond, 2>{ quaterniond(0, 0, 1, 0), quaterniond(0, 1, 0, 0) })[1] ==
+              quaterniond(0, 0, 0, -1), "Fixed-size kernels must unroll at compile time");
+#ifdef __cpp_lib_is_constant_evaluated
+static_assert(multiply(std::array<quaternionf, 9>{ quaternionf(0, 1, 0, 0) },
+                       std::array<quaternionf, 9>{ quaternionf(0, 0, 1, 0) })[0] == quaternionf(0, 0, 0, 1) &&
+              add(std::array<quaternionf, HC_FIXED_UNROLL_MAX + 1>{ quaternionf(1, 2, 3, 4) },
+                  std::array<quaternionf, HC_FIXED_UNROLL_MAX + 1>{})[0] == quaternionf(1, 2, 3, 4),
+              "Float fixed-size kernels must fold at compile time");
+#endif
+static_assert(rotate(inverse(unit_quaterniond::from_unit(quaterniond(0, 0, 0, 1))), { 1.0, 2.0, 3.0 })[0] == -1.0,
+              "Unit rotation must fold at compile time");
+
+} // namespace hc
+
+#endif /* __cplusplus */
+
+#endif /* HYPERCOMPLEX_H */
+
+/*
+ * Implementation file: hypercomplex.c
+ */
+
+#define _GNU_SOURCE
+#include "hypercomplex.h"
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HC_SIMD_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#define HC_SIMD_SSE 1
+#endif
+
+/*
+ * USDT tracepoints: compiled in whenever <sys/sdt.h> is available (header only,
+ * no runtime dependency). An inactive probe is a single nop; -DHC_DISABLE_USDT
+ * removes them entirely.
+ */
+#if !defined(HC_DISABLE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define HC_USDT 1
+#endif
+#endif
+
+#ifdef HC_USDT
+#define HC_PROBE1(name, a) DTRACE_PROBE1(hypercomplex, name, a)
+#define HC_PROBE2(name, a, b) DTRACE_PROBE2(hypercomplex, name, a, b)
+#define HC_PROBE3(name, a, b, c) DTRACE_PROBE3(hypercomplex, name, a, b, c)
+#else
+#define HC_PROBE1(name, a) ((void)0)
+#define HC_PROBE2(name, a, b) ((void)0)
+#define HC_PROBE3(name, a, b, c) ((void)0)
+#endif
+
+static uint64_t hc_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Runtime statistics
+ */
+
+static inline int hist_bucket(uint64_t ns) {
+    if (ns < (2u << HC_HIST_SUB_BITS)) return (int)ns;
+    
+    int shift = 63 - __builtin_clzll(ns) - HC_HIST_SUB_BITS;
+    if (shift > HC_HIST_MAX_SHIFT) return HC_HIST_BUCKETS - 1;
+    
+    // The mantissa keeps the top SUB_BITS + 1 bits, so its leading one marks the octave
+    uint64_t mantissa = ns >> shift;
+    return (shift + 1) * (1 << HC_HIST_SUB_BITS) + (int)(mantissa - (1u << HC_HIST_SUB_BITS));
+}
+
+static uint64_t hist_bucket_upper(int index) {
+    if (index < (2 << HC_HIST_SUB_BITS)) return (uint64_t)index;
+    
+    int shift = index / (1 << HC_HIST_SUB_BITS) - 1;
+    uint64_t mantissa = (uint64_t)(1 << HC_HIST_SUB_BITS) + (uint64_t)(index % (1 << HC_HIST_SUB_BITS));
+    return ((mantissa + 1) << shift) - 1;
+}
+
+hc_size_class_t hc_size_class(size_t bytes) {
+    if (bytes <= 64) return HC_SIZE_CLASS_64;
+    if (bytes <= 512) return HC_SIZE_CLASS_512;
+    if (bytes <= 4096) return HC_SIZE_CLASS_4K;
+    if (bytes <= 65536) return HC_SIZE_CLASS_64K;
+    return HC_SIZE_CLASS_LARGE;
+}
+
+const char* hc_size_class_name(hc_size_class_t size_class) {
+    static const char* const names[HC_SIZE_CLASS_COUNT] = { "<=64B", "<=512B", "<=4KiB", "<=64KiB", ">64KiB" };
+    
+    if ((unsigned)size_class >= HC_SIZE_CLASS_COUNT) return "unknown";
+    return names[size_class];
+}
+
+void hc_histogram_record(hc_histogram_t* hist, uint64_t ns) {
+    if (!hist) return;
+    
+    hist->buckets[hist_bucket(ns)]++;
+    hist->count++;
+}
+
+void hc_histogram_merge(hc_histogram_t* into, const hc_histogram_t* from) {
+    if (!into || !from) return;
+    
+    for (int i = 0; i < HC_HIST_BUCKETS; i++) {
+        into->buckets[i] += from->buckets[i];
+    }
+    into->count += from->count;
+}
+
+uint64_t hc_histogram_percentile(const hc_histogram_t* hist, double percentile) {
+    if (!hist || hist->count == 0) return 0;
+    
+    if (percentile > 100.0) percentile = 100.0;
+    uint64_t target = (uint64_t)ceil(percentile / 100.0 * (double)hist->count);
+    if (target == 0) target = 1;
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < HC_HIST_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) return hist_bucket_upper(i);
+    }
+    
+    return hist_bucket_upper(HC_HIST_BUCKETS - 1);
+}
+
+uint64_t hc_histogram_max(const hc_histogram_t* hist) {
+    return hc_histogram_percentile(hist, 100.0);
+}
+
+#define HC_CACHE_LINE 64
+
+#ifdef HC_ENABLE_STATS
+
+// Written only by the owning thread, so updates are plain relaxed load/store pairs
+typedef struct {
+    _Alignas(HC_CACHE_LINE) _Atomic uint64_t calls;
+    _Atomic uint64_t bytes;
+    _Atomic uint64_t total_ns;
+    _Atomic uint64_t errors[HC_STATS_ERROR_SLOTS];
+} stats_slot_t;
+
+typedef struct {
+    _Atomic uint64_t buckets[HC_HIST_BUCKETS];
+} stats_hist_t;
+
+#define FLIGHT_WORDS (sizeof(hc_flight_entry_t) / sizeof(uint64_t))
+_Static_assert(sizeof(hc_flight_entry_t) % sizeof(uint64_t) == 0, "flight entries are copied as whole words");
+
+// One entry behind a seqlock: odd while the owner is writing it, so readers on
+// other threads (or in a signal handler) can tell a torn copy and skip it
+typedef struct {
+    _Atomic uint64_t sequence;
+    _Atomic uint64_t words[FLIGHT_WORDS];
+} flight_slot_t;
+
+// Only the owning thread writes head. hc_flight_reset moves start up to head
+// instead of rewinding head under a recording owner.
+typedef struct {
+    flight_slot_t slots[HC_FLIGHT_RING_SIZE];
+    _Atomic uint64_t head;                   // Entries ever written; head % size is the next slot
+    _Atomic uint64_t start;                  // head at the last reset; older entries are hidden
+} flight_ring_t;
+
+typedef struct stats_thread {
+    stats_slot_t apis[HC_API_COUNT];
+    stats_hist_t hist[HC_API_COUNT][HC_SIZE_CLASS_COUNT];
+    flight_ring_t flight;
+    uint32_t thread_id;
+    struct stats_thread* next;
+    _Atomic int in_use;
+} stats_thread_t;
+
+static _Atomic unsigned stats_flags;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+static stats_thread_t* _Atomic stats_threads;    // Every block ever handed out, never freed
+static hc_stats_t stats_reset_base;          // Totals at the last reset
+static hc_histogram_t stats_hist_base[HC_API_COUNT][HC_SIZE_CLASS_COUNT];
+static _Thread_local stats_thread_t* stats_local;
+
+// Exited threads hand their block to the next new thread; totals carry over
+static void stats_thread_exit(void* block) {
+    atomic_store_explicit(&((stats_thread_t*)block)->in_use, 0, memory_order_release);
+}
+
+static void stats_init_key(void) {
+    pthread_key_create(&stats_key, stats_thread_exit);
+}
+
+static stats_thread_t* stats_register_thread(void) {
+    stats_thread_t* block = NULL;
+    
+    pthread_once(&stats_once, stats_init_key);
+    pthread_mutex_lock(&stats_lock);
+    
+    for (stats_thread_t* t = stats_threads; t && !block; t = t->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&t->in_use, &expected, 1)) block = t;
+    }
+    
+    if (!block) {
+        block = hc_aligned_alloc(sizeof(*block), HC_CACHE_LINE);
+        if (block) {
+            memset(block, 0, sizeof(*block));
+            atomic_store(&block->in_use, 1);
+            block->next = stats_threads;
+            stats_threads = block;
+        }
+    }
+    
+    pthread_mutex_unlock(&stats_lock);
+    
+    if (block) {
+#ifdef __linux__
+        block->thread_id = (uint32_t)syscall(SYS_gettid);
+#else
+        block->thread_id = (uint32_t)(uintptr_t)block;
+#endif
+        pthread_setspecific(stats_key, block);
+    }
+    stats_local = block;
+    return block;
+}
+
+static inline void stats_add(_Atomic uint64_t* counter, uint64_t value) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value,
+                          memory_order_relaxed);
+}
+
+static _Atomic uint64_t flight_threshold;
+
+static inline uint64_t stats_begin(void) {
+    return (atomic_load_explicit(&stats_flags, memory_order_relaxed) ||
+            atomic_load_explicit(&flight_threshold, memory_order_relaxed)) ? hc_now_ns() : 0;
+}
+
+static void tuning_snapshot(hc_tuning_t* t);
+
+// Slow path, taken only for calls over the threshold
+static void flight_record(stats_thread_t* block, hc_api_t api, size_t bytes, int status,
+                          uint64_t elapsed) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    
+    uint64_t head = atomic_load_explicit(&block->flight.head, memory_order_relaxed);
+    flight_slot_t* slot = &block->flight.slots[head % HC_FLIGHT_RING_SIZE];
+    int batch = (api >= HC_API_MULTIPLY_BATCH);
+    hc_tuning_t tuned;
+    hc_flight_entry_t e;
+    uint64_t words[FLIGHT_WORDS];
+    
+    if (batch) tuning_snapshot(&tuned);
+    memset(&e, 0, sizeof(e));
+    e.timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec - elapsed;
+    e.duration_ns = elapsed;
+    e.bytes = bytes;
+    e.api = api;
+#ifdef __aarch64__
+    e.backend = batch ? (int)tuned.batch_backend : HC_BACKEND_ASM;
+#else
+    e.backend = batch ? (int)tuned.batch_backend : HC_BACKEND_SCALAR;
+#endif
+    e.status = status;
+    e.thread_id = block->thread_id;
+    memcpy(words, &e, sizeof(e));
+    
+    uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (size_t w = 0; w < FLIGHT_WORDS; w++) {
+        atomic_store_explicit(&slot->words[w], words[w], memory_order_relaxed);
+    }
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+    
+    atomic_store_explicit(&block->flight.head, head + 1, memory_order_release);
+}
+
+static void stats_end(hc_api_t api, size_t bytes, int status, uint64_t start) {
+    if (!start) return;
+    
+    uint64_t elapsed = hc_now_ns() - start;
+    unsigned flags = atomic_load_explicit(&stats_flags, memory_order_relaxed);
+    uint64_t threshold = atomic_load_explicit(&flight_threshold, memory_order_relaxed);
+    int slow = threshold && elapsed >= threshold;
+    if (!flags && !slow) return;
+    
+    stats_thread_t* block = stats_local ? stats_local : stats_register_thread();
+    if (!block) return;
+    
+    if (slow) flight_record(block, api, bytes, status, elapsed);
+    
+    if (flags & HC_STATS_HISTOGRAMS) {
+        stats_add(&block->hist[api][hc_size_class(bytes)].buckets[hist_bucket(elapsed)], 1);
+    }
+    
+    if (!(flags & HC_STATS_COUNTERS)) return;
+    
+    stats_slot_t* slot = &block->apis[api];
+    stats_add(&slot->calls, 1);
+    stats_add(&slot->bytes, bytes);
+    stats_add(&slot->total_ns, elapsed);
+    
+    if (status != HC_SUCCESS) {
+        int index = (status < 0 && -status < HC_STATS_ERROR_SLOTS) ? -status : 0;
+        stats_add(&slot->errors[index], 1);
+    }
+}
+
+// Raw bucket totals across threads; callers hold stats_lock
+static void stats_collect_hist(hc_api_t api, hc_size_class_t size_class, hc_histogram_t* hist) {
+    memset(hist, 0, sizeof(*hist));
+    
+    for (stats_thread_t* t = stats_threads; t; t = t->next) {
+        const stats_hist_t* h = &t->hist[api][size_class];
+        for (int i = 0; i < HC_HIST_BUCKETS; i++) {
+            uint64_t n = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+            hist->buckets[i] += n;
+            hist->count += n;
+        }
+    }
+}
+
+// Raw totals across threads; callers hold stats_lock
+static void stats_collect(hc_stats_t* totals) {
+    memset(totals, 0, sizeof(*totals));
+    
+    for (stats_thread_t* t = stats_threads; t; t = t->next) {
+        for (int api = 0; api < HC_API_COUNT; api++) {
+            const stats_slot_t* slot = &t->apis[api];
+            hc_api_stats_t* out = &totals->apis[api];
+            
+            out->calls += atomic_load_explicit(&slot->calls, memory_order_relaxed);
+            out->bytes += atomic_load_explicit(&slot->bytes, memory_order_relaxed);
+            out->total_ns += atomic_load_explicit(&slot->total_ns, memory_order_relaxed);
+            for (int e = 0; e < HC_STATS_ERROR_SLOTS; e++) {
+                out->errors[e] += atomic_load_explicit(&slot->errors[e], memory_order_relaxed);
+            }
+        }
+    }
+}
+
+int hc_stats_enable(unsigned flags) {
+    atomic_store_explicit(&stats_flags, flags, memory_order_relaxed);
+    return HC_SUCCESS;
+}
+
+unsigned hc_stats_enabled(void) {
+    return atomic_load_explicit(&stats_flags, memory_order_relaxed);
+}
+
+int hc_stats_snapshot(hc_stats_t* stats) {
+    if (!stats) return HC_ERROR_NULL_PTR;
+    
+    pthread_mutex_lock(&stats_lock);
+    stats_collect(stats);
+    
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        hc_api_stats_t* out = &stats->apis[api];
+        const hc_api_stats_t* base = &stats_reset_base.apis[api];
+        
+        out->calls -= base->calls;
+        out->bytes -= base->bytes;
+        out->total_ns -= base->total_ns;
+        for (int e = 0; e < HC_STATS_ERROR_SLOTS; e++) {
+            out->errors[e] -= base->errors[e];
+        }
+    }
+    
+    pthread_mutex_unlock(&stats_lock);
+    return HC_SUCCESS;
+}
+
+void hc_stats_reset(void) {
+    // Writers are never stopped; the current totals become the new zero
+    pthread_mutex_lock(&stats_lock);
+    stats_collect(&stats_reset_base);
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        for (int c = 0; c < HC_SIZE_CLASS_COUNT; c++) {
+            stats_collect_hist((hc_api_t)api, (hc_size_class_t)c, &stats_hist_base[api][c]);
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+}
+
+int hc_histogram_snapshot(hc_api_t api, hc_size_class_t size_class, hc_histogram_t* hist) {
+    if (!hist) return HC_ERROR_NULL_PTR;
+    if ((unsigned)api >= HC_API_COUNT || (unsigned)size_class >= HC_SIZE_CLASS_COUNT) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    pthread_mutex_lock(&stats_lock);
+    stats_collect_hist(api, size_class, hist);
+    
+    const hc_histogram_t* base = &stats_hist_base[api][size_class];
+    for (int i = 0; i < HC_HIST_BUCKETS; i++) {
+        hist->buckets[i] -= base->buckets[i];
+    }
+    hist->count -= base->count;
+    
+    pthread_mutex_unlock(&stats_lock);
+    return HC_SUCCESS;
+}
+
+int hc_flight_enable(uint64_t threshold_ns) {
+    atomic_store_explicit(&flight_threshold, threshold_ns, memory_order_relaxed);
+    return HC_SUCCESS;
+}
+
+uint64_t hc_flight_threshold(void) {
+    return atomic_load_explicit(&flight_threshold, memory_order_relaxed);
+}
+
+void hc_flight_reset(void) {
+    pthread_mutex_lock(&stats_lock);
+    for (stats_thread_t* t = stats_threads; t; t = t->next) {
+        uint64_t head = atomic_load_explicit(&t->flight.head, memory_order_acquire);
+        atomic_store_explicit(&t->flight.start, head, memory_order_release);
+    }
+    pthread_mutex_unlock(&stats_lock);
+}
+
+// Oldest entry still in the ring and not hidden by a reset
+static uint64_t flight_first(const flight_ring_t* ring, uint64_t head) {
+    uint64_t start = atomic_load_explicit(&ring->start, memory_order_acquire);
+    uint64_t first = head > HC_FLIGHT_RING_SIZE ? head - HC_FLIGHT_RING_SIZE : 0;
+    return start > first ? start : first;
+}
+
+// Copies one slot without retrying, so it is safe in a signal handler that
+// interrupted the writer; 0 when the slot was being written during the copy
+static int flight_read(const flight_slot_t* slot, hc_flight_entry_t* e) {
+    uint64_t words[FLIGHT_WORDS];
+    uint64_t before = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    if (before & 1) return 0;
+    
+    for (size_t w = 0; w < FLIGHT_WORDS; w++) {
+        words[w] = atomic_load_explicit(&slot->words[w], memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != before) return 0;
+    
+    memcpy(e, words, sizeof(*e));
+    return 1;
+}
+
+static int flight_compare(const void* a, const void* b) {
+    uint64_t x = ((const hc_flight_entry_t*)a)->timestamp_ns;
+    uint64_t y = ((const hc_flight_entry_t*)b)->timestamp_ns;
+    return (x > y) - (x < y);
+}
+
+int hc_flight_snapshot(hc_flight_entry_t* entries, size_t capacity, size_t* count) {
+    if (!entries || !count) return HC_ERROR_NULL_PTR;
+    
+    *count = 0;
+    pthread_mutex_lock(&stats_lock);
+    
+    size_t total = 0;
+    for (stats_thread_t* t = stats_threads; t; t = t->next) {
+        uint64_t head = atomic_load_explicit(&t->flight.head, memory_order_acquire);
+        total += head - flight_first(&t->flight, head);
+    }
+    
+    hc_flight_entry_t* all = total ? malloc(total * sizeof(*all)) : NULL;
+    if (total && !all) {
+        pthread_mutex_unlock(&stats_lock);
+        return HC_ERROR_NO_MEMORY;
+    }
+    
+    size_t n = 0;
+    for (stats_thread_t* t = stats_threads; t && n < total; t = t->next) {
+        uint64_t head = atomic_load_explicit(&t->flight.head, memory_order_acquire);
+        for (uint64_t i = flight_first(&t->flight, head); i < head && n < total; i++) {
+            n += flight_read(&t->flight.slots[i % HC_FLIGHT_RING_SIZE], &all[n]);
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+    
+    if (n > 1) qsort(all, n, sizeof(*all), flight_compare);
+    size_t skip = n > capacity ? n - capacity : 0;
+    if (n > skip) memcpy(entries, all + skip, (n - skip) * sizeof(*all));
+    *count = n - skip;
+    
+    free(all);
+    return HC_SUCCESS;
+}
+
+// Minimal formatting for the signal path: no locks, no stdio, no allocation
+static void flight_put(char* line, size_t* len, size_t size, const char* text) {
+    while (*text && *len + 1 < size) line[(*len)++] = *text++;
+}
+
+static void flight_put_u64(char* line, size_t* len, size_t size, uint64_t value) {
+    char digits[20];
+    int n = 0;
+    
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n && *len + 1 < size) line[(*len)++] = digits[--n];
+}
+
+static void flight_write(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written <= 0) return;
+        data += written;
+        len -= (size_t)written;
+    }
+}
+
+int hc_flight_dump(int fd) {
+    char line[256];
+    size_t len = 0;
+    
+    flight_put(line, &len, sizeof(line), "hypercomplex flight recorder, threshold_ns=");
+    flight_put_u64(line, &len, sizeof(line), atomic_load_explicit(&flight_threshold, memory_order_relaxed));
+    flight_put(line, &len, sizeof(line), "\n");
+    flight_write(fd, line, len);
+    
+    // The thread list only ever grows at the front, so it can be walked without the lock
+    for (stats_thread_t* t = atomic_load_explicit(&stats_threads, memory_order_acquire); t; t = t->next) {
+        uint64_t head = atomic_load_explicit(&t->flight.head, memory_order_acquire);
+        
+        for (uint64_t i = flight_first(&t->flight, head); i < head; i++) {
+            hc_flight_entry_t e;
+            if (!flight_read(&t->flight.slots[i % HC_FLIGHT_RING_SIZE], &e)) continue;
+            
+            len = 0;
+            flight_put(line, &len, sizeof(line), "tid=");
+            flight_put_u64(line, &len, sizeof(line), e.thread_id);
+            flight_put(line, &len, sizeof(line), " start_ns=");
+            flight_put_u64(line, &len, sizeof(line), e.timestamp_ns);
+            flight_put(line, &len, sizeof(line), " api=");
+            flight_put(line, &len, sizeof(line), hc_api_name(e.api));
+            flight_put(line, &len, sizeof(line), " bytes=");
+            flight_put_u64(line, &len, sizeof(line), e.bytes);
+            flight_put(line, &len, sizeof(line), " backend=");
+            flight_put(line, &len, sizeof(line), hc_backend_name((hc_backend_t)e.backend));
+            flight_put(line, &len, sizeof(line), " duration_ns=");
+            flight_put_u64(line, &len, sizeof(line), e.duration_ns);
+            flight_put(line, &len, sizeof(line), e.status < 0 ? " status=-" : " status=");
+            flight_put_u64(line, &len, sizeof(line), (uint64_t)(e.status < 0 ? -e.status : e.status));
+            flight_put(line, &len, sizeof(line), "\n");
+            flight_write(fd, line, len);
+        }
+    }
+    
+    return HC_SUCCESS;
+}
+
+static _Atomic int flight_fd = 2;
+
+static void flight_signal(int signo) {
+    int saved_errno = errno;
+    (void)signo;
+    
+    hc_flight_dump(atomic_load_explicit(&flight_fd, memory_order_relaxed));
+    errno = saved_errno;
+}
+
+int hc_flight_install_signal(int signo, int fd) {
+    struct sigaction action;
+    
+    if (fd < 0) return HC_ERROR_INVALID_DATA;
+    atomic_store(&flight_fd, fd);
+    
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = flight_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    
+    return sigaction(signo ? signo : SIGUSR2, &action, NULL) == 0 ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+}
+
+#else
+
+#define stats_begin() ((uint64_t)0)
+#define stats_end(api, bytes, status, start) ((void)(start))
+
+int hc_stats_enable(unsigned flags) {
+    (void)flags;
+    return HC_ERROR_UNSUPPORTED;
+}
+
+unsigned hc_stats_enabled(void) {
+    return 0;
+}
+
+int hc_stats_snapshot(hc_stats_t* stats) {
+    if (!stats) return HC_ERROR_NULL_PTR;
+    
+    memset(stats, 0, sizeof(*stats));
+    return HC_ERROR_UNSUPPORTED;
+}
+
+void hc_stats_reset(void) {
+}
+
+int hc_histogram_snapshot(hc_api_t api, hc_size_class_t size_class, hc_histogram_t* hist) {
+    (void)api;
+    (void)size_class;
+    if (!hist) return HC_ERROR_NULL_PTR;
+    
+    memset(hist, 0, sizeof(*hist));
+    return HC_ERROR_UNSUPPORTED;
+}
+
+int hc_flight_enable(uint64_t threshold_ns) {
+    (void)threshold_ns;
+    return HC_ERROR_UNSUPPORTED;
+}
+
+uint64_t hc_flight_threshold(void) {
+    return 0;
+}
+
+void hc_flight_reset(void) {
+}
+
+int hc_flight_snapshot(hc_flight_entry_t* entries, size_t capacity, size_t* count) {
+    (void)capacity;
+    if (!entries || !count) return HC_ERROR_NULL_PTR;
+    
+    *count = 0;
+    return HC_ERROR_UNSUPPORTED;
+}
+
+int hc_flight_dump(int fd) {
+    (void)fd;
+    return HC_ERROR_UNSUPPORTED;
+}
+
+int hc_flight_install_signal(int signo, int fd) {
+    (void)signo;
+    (void)fd;
+    return HC_ERROR_UNSUPPORTED;
+}
+
+#endif /* HC_ENABLE_STATS */
+
+const char* hc_api_name(hc_api_t api) {
+    static const char* const names[HC_API_COUNT] = {
+        "generate_key", "encrypt_data", "decrypt_data",
+        "multiply_batch", "add_batch", "conjugate_batch", "normalize_batch"
+    };
+    
+    if ((unsigned)api >= HC_API_COUNT) return "unknown";
+    return names[api];
+}
+
+/*
+ * Scalar kernels and portable core
+ */
+
+static const float norm_epsilon = 1e-6f;     // Matches epsilon in the assembly core
+
+// Kept out of line so the scalar backend measures one call per quaternion, like the assembly
+__attribute__((noinline)) static void scalar_multiply(const quaternion_t* a, const quaternion_t* b,
+                                                      quaternion_t* result) {
+    quaternion_t r;
+    
+    r.w = a->w * b->w - a->x * b->x - a->y * b->y - a->z * b->z;
+    r.x = a->w * b->x + a->x * b->w + a->y * b->z - a->z * b->y;
+    r.y = a->w * b->y - a->x * b->z + a->y * b->w + a->z * b->x;
+    r.z = a->w * b->z + a->x * b->y - a->y * b->x + a->z * b->w;
+    
+    *result = r;
+}
+
+__attribute__((noinline)) static void scalar_add(const quaternion_t* a, const quaternion_t* b,
+                                                 quaternion_t* result) {
+    quaternion_t r = { a->w + b->w, a->x + b->x, a->y + b->y, a->z + b->z };
+    *result = r;
+}
+
+__attribute__((noinline)) static void scalar_conjugate(const quaternion_t* a, quaternion_t* result) {
+    quaternion_t r = { a->w, -a->x, -a->y, -a->z };
+    *result = r;
+}
+
+__attribute__((noinline)) static float scalar_norm(const quaternion_t* a) {
+    return sqrtf(a->w * a->w + a->x * a->x + a->y * a->y + a->z * a->z);
+}
+
+__attribute__((noinline)) static int scalar_normalize(const quaternion_t* a, quaternion_t* result) {
+    float norm = scalar_norm(a);
+    if (norm < norm_epsilon) return HC_ERROR_DIVIDE_ZERO;
+    
+    quaternion_t r = { a->w / norm, a->x / norm, a->y / norm, a->z / norm };
+    *result = r;
+    return HC_SUCCESS;
+}
+
+#ifndef __aarch64__
+
+// Other hosts get the assembly core's behaviour in C, so the library builds and runs natively
+int quaternion_multiply(const quaternion_t* q1, const quaternion_t* q2, quaternion_t* result) {
+    if (!q1 || !q2 || !result) return HC_ERROR_NULL_PTR;
+    
+    scalar_multiply(q1, q2, result);
+    return HC_SUCCESS;
+}
+
+int quaternion_add(const quaternion_t* q1, const quaternion_t* q2, quaternion_t* result) {
+    if (!q1 || !q2 || !result) return HC_ERROR_NULL_PTR;
+    
+    scalar_add(q1, q2, result);
+    return HC_SUCCESS;
+}
+
+int quaternion_conjugate(const quaternion_t* input, quaternion_t* result) {
+    if (!input || !result) return HC_ERROR_NULL_PTR;
+    
+    scalar_conjugate(input, result);
+    return HC_SUCCESS;
+}
+
+float quaternion_norm(const quaternion_t* q) {
+    if (!q) return NAN;
+    
+    return scalar_norm(q);
+}
+
+int quaternion_normalize(const quaternion_t* input, quaternion_t* result) {
+    if (!input || !result) return HC_ERROR_NULL_PTR;
+    
+    return scalar_normalize(input, result);
+}
+
+int hypercomplex_encrypt(const void* input, const quaternion_t* key, void* output, size_t length) {
+    if (!input || !key || !output || length == 0) return HC_ERROR_NULL_PTR;
+    
+    const quaternion_t* src = (const quaternion_t*)input;
+    quaternion_t* dst = (quaternion_t*)output;
+    quaternion_t temp;
+    
+    // Whole 16-byte blocks only; a trailing partial block is left untouched
+    for (; length >= sizeof(quaternion_t); length -= sizeof(quaternion_t)) {
+        scalar_multiply(src++, key, &temp);
+        scalar_conjugate(&temp, dst++);
+    }
+    
+    return HC_SUCCESS;
+}
+
+#endif /* __aarch64__ */
+
+/*
+ * Kernel backends
+ */
+
+// One pass over `count` elements; unary kernels ignore b, the norm kernel writes floats to out.
+// Normalize returns HC_ERROR_DIVIDE_ZERO after the pass if any element was near zero.
+typedef int (*backend_fn_t)(const quaternion_t* a, const quaternion_t* b,
+                            quaternion_t* out, size_t count);
+
+static int scalar_multiply_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) scalar_multiply(&a[i], &b[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int scalar_add_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) scalar_add(&a[i], &b[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int scalar_conjugate_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    (void)b;
+    for (size_t i = 0; i < count; i++) scalar_conjugate(&a[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int scalar_norm_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    float* norms = (float*)out;
+    (void)b;
+    for (size_t i = 0; i < count; i++) norms[i] = scalar_norm(&a[i]);
+    return HC_SUCCESS;
+}
+
+static int scalar_normalize_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    int status = HC_SUCCESS;
+    (void)b;
+    for (size_t i = 0; i < count; i++) {
+        if (scalar_normalize(&a[i], &out[i]) != HC_SUCCESS) status = HC_ERROR_DIVIDE_ZERO;
+    }
+    return status;
+}
+
+#ifdef __aarch64__
+
+static int asm_multiply_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) quaternion_multiply(&a[i], &b[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int asm_add_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) quaternion_add(&a[i], &b[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int asm_conjugate_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    (void)b;
+    for (size_t i = 0; i < count; i++) quaternion_conjugate(&a[i], &out[i]);
+    return HC_SUCCESS;
+}
+
+static int asm_norm_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    float* norms = (float*)out;
+    (void)b;
+    for (size_t i = 0; i < count; i++) norms[i] = quaternion_norm(&a[i]);
+    return HC_SUCCESS;
+}
+
+static int asm_normalize_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    int status = HC_SUCCESS;
+    (void)b;
+    for (size_t i = 0; i < count; i++) {
+        if (quaternion_normalize(&a[i], &out[i]) != HC_SUCCESS) status = HC_ERROR_DIVIDE_ZERO;
+    }
+    return status;
+}
+
+#endif /* __aarch64__ */
+
+// Plain loops the compiler can vectorize; each element goes through locals so in-place calls work
+static int autovec_multiply_n(const quaternion_t* q1, const quaternion_t* q2, quaternion_t* result, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const quaternion_t a = q1[i];
+        const quaternion_t b = q2[i];
+        quaternion_t r;
+        
+        r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+        r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+        r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+        r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+        
+        result[i] = r;
+    }
+    
+    return HC_SUCCESS;
+}
+
+static int autovec_add_n(const quaternion_t* q1, const quaternion_t* q2, quaternion_t* result, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const quaternion_t a = q1[i];
+        const quaternion_t b = q2[i];
+        quaternion_t r = { a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z };
+        result[i] = r;
+    }
+    
+    return HC_SUCCESS;
+}
+
+static int autovec_conjugate_n(const quaternion_t* input, const quaternion_t* unused,
+                               quaternion_t* result, size_t count) {
+    (void)unused;
+    for (size_t i = 0; i < count; i++) {
+        const quaternion_t a = input[i];
+        quaternion_t r = { a.w, -a.x, -a.y, -a.z };
+        result[i] = r;
+    }
+    
+    return HC_SUCCESS;
+}
+
+static int autovec_norm_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    float* norms = (float*)out;
+    (void)b;
+    for (size_t i = 0; i < count; i++) {
+        norms[i] = sqrtf(a[i].w * a[i].w + a[i].x * a[i].x + a[i].y * a[i].y + a[i].z * a[i].z);
+    }
+    
+    return HC_SUCCESS;
+}
+
+static int autovec_normalize_n(const quaternion_t* input, const quaternion_t* unused,
+                               quaternion_t* result, size_t count) {
+    int zero_found = 0;
+    (void)unused;
+    
+    // Branch-free select keeps the loop vectorizable
+    for (size_t i = 0; i < count; i++) {
+        const quaternion_t a = input[i];
+        float norm = sqrtf(a.w * a.w + a.x * a.x + a.y * a.y + a.z * a.z);
+        int zero = norm < norm_epsilon;
+        float divisor = zero ? 1.0f : norm;
+        
+        quaternion_t r = { a.w / divisor, a.x / divisor, a.y / divisor, a.z / divisor };
+        result[i] = r;
+        zero_found |= zero;
+    }
+    
+    return zero_found ? HC_ERROR_DIVIDE_ZERO : HC_SUCCESS;
+}
+// Non-temporal stores are weakly ordered; publish them before results are handed back
+static inline void stream_fence(void) {
+#if defined(HC_SIMD_SSE)
+    _mm_sfence();
+#elif defined(__aarch64__)
+    __asm__ volatile("dmb ishst" : : : "memory");
+#endif
+}
+
+// Store modes for the SIMD kernel bodies. Each entry point passes a constant,
+// so after inlining it keeps only its own loads and stores.
+#define SIMD_ALIGNED 1               // Every pointer 16-byte aligned
+#define SIMD_STREAM  2               // Non-temporal output stores; inputs prefetched ahead
+
+#define SIMD_PREFETCH_AHEAD 32       // Quaternions (512 bytes) ahead of the current load
+
+#if defined(HC_SIMD_NEON)
+
+// stnp: two quaternions written with a hint not to keep the line in cache
+static inline void simd_stream_pair(quaternion_t* out, float32x4_t lo, float32x4_t hi) {
+    __asm__ volatile("stnp %q1, %q2, [%0]" : : "r"(out), "w"(lo), "w"(hi) : "memory");
+}
+
+// Component-major registers back to four interleaved quaternions, streamed as two pairs
+static inline void simd_stream4(quaternion_t* out, float32x4x4_t r) {
+    float32x4_t wy_lo = vzip1q_f32(r.val[0], r.val[2]), xz_lo = vzip1q_f32(r.val[1], r.val[3]);
+    float32x4_t wy_hi = vzip2q_f32(r.val[0], r.val[2]), xz_hi = vzip2q_f32(r.val[1], r.val[3]);
+    
+    simd_stream_pair(out, vzip1q_f32(wy_lo, xz_lo), vzip2q_f32(wy_lo, xz_lo));
+    simd_stream_pair(out + 2, vzip1q_f32(wy_hi, xz_hi), vzip2q_f32(wy_hi, xz_hi));
+}
+
+// Four quaternions per step; vld4q splits them into one register per component.
+// A64 has no separate aligned load, so SIMD_ALIGNED changes nothing here.
+static inline int simd_multiply_body(const quaternion_t* a, const quaternion_t* b, quaternion_t* out,
+                                     size_t count, int mode) {
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        if (mode & SIMD_STREAM) {
+            __builtin_prefetch(&a[i + SIMD_PREFETCH_AHEAD], 0, 0);
+            __builtin_prefetch(&b[i + SIMD_PREFETCH_AHEAD], 0, 0);
+        }
+        
+        float32x4x4_t p = vld4q_f32(&a[i].w);
+        float32x4x4_t q = vld4q_f32(&b[i].w);
+        float32x4x4_t r;
+        
+        r.val[0] = vmulq_f32(p.val[0], q.val[0]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[1], q.val[1]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[2], q.val[2]);
+        r.val[0] = vfmsq_f32(r.val[0], p.val[3], q.val[3]);
+        
+        r.val[1] = vmulq_f32(p.val[0], q.val[1]);
+        r.val[1] = vfmaq_f32(r.val[1], p.val[1], q.val[0]);
+        r.val[1] = vfmaq_f32(r.val[1], p.val[2], q.val[3]);
+        r.val[1] = vfmsq_f32(r.val[1], p.val[3], q.val[2]);
+        
+        r.val[2] = vmulq_f32(p.val[0], q.val[2]);
+        r.val[2] = vfmsq_f32(r.val[2], p.val[1], q.val[3]);
+        r.val[2] = vfmaq_f32(r.val[2], p.val[2], q.val[0]);
+        r.val[2] = vfmaq_f32(r.val[2], p.val[3], q.val[1]);
+        
+        r.val[3] = vmulq_f32(p.val[0], q.val[3]);
+        r.val[3] = vfmaq_f32(r.val[3], p.val[1], q.val[2]);
+        r.val[3] = vfmsq_f32(r.val[3], p.val[2], q.val[1]);
+        r.val[3] = vfmaq_f32(r.val[3], p.val[3], q.val[0]);
+        
+        if (mode & SIMD_STREAM) {
+            simd_stream4(&out[i], r);
+        } else {
+            vst4q_f32(&out[i].w, r);
+        }
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    return autovec_multiply_n(a + i, b + i, out + i, count - i);
+}
+
+static inline int simd_add_body(const quaternion_t* a, const quaternion_t* b, quaternion_t* out,
+                                size_t count, int mode) {
+    size_t i = 0;
+    
+    if (mode & SIMD_STREAM) {
+        for (; i + 2 <= count; i += 2) {
+            if ((i & 3) == 0) {
+                __builtin_prefetch(&a[i + SIMD_PREFETCH_AHEAD], 0, 0);
+                __builtin_prefetch(&b[i + SIMD_PREFETCH_AHEAD], 0, 0);
+            }
+            simd_stream_pair(&out[i], vaddq_f32(vld1q_f32(&a[i].w), vld1q_f32(&b[i].w)),
+                             vaddq_f32(vld1q_f32(&a[i + 1].w), vld1q_f32(&b[i + 1].w)));
+        }
+        stream_fence();
+    }
+    
+    for (; i < count; i++) {
+        vst1q_f32(&out[i].w, vaddq_f32(vld1q_f32(&a[i].w), vld1q_f32(&b[i].w)));
+    }
+    
+    return HC_SUCCESS;
+}
+
+static inline int simd_conjugate_body(const quaternion_t* a, quaternion_t* out, size_t count, int mode) {
+    static const uint32_t signs[4] = { 0, 0x80000000u, 0x80000000u, 0x80000000u };
+    uint32x4_t mask = vld1q_u32(signs);
+    size_t i = 0;
+    
+    if (mode & SIMD_STREAM) {
+        for (; i + 2 <= count; i += 2) {
+            if ((i & 3) == 0) __builtin_prefetch(&a[i + SIMD_PREFETCH_AHEAD], 0, 0);
+            uint32x4_t lo = veorq_u32(vreinterpretq_u32_f32(vld1q_f32(&a[i].w)), mask);
+            uint32x4_t hi = veorq_u32(vreinterpretq_u32_f32(vld1q_f32(&a[i + 1].w)), mask);
+            simd_stream_pair(&out[i], vreinterpretq_f32_u32(lo), vreinterpretq_f32_u32(hi));
+        }
+        stream_fence();
+    }
+    
+    for (; i < count; i++) {
+        uint32x4_t q = vreinterpretq_u32_f32(vld1q_f32(&a[i].w));
+        vst1q_f32(&out[i].w, vreinterpretq_f32_u32(veorq_u32(q, mask)));
+    }
+    
+    return HC_SUCCESS;
+}
+
+static inline float32x4_t simd_norm4(float32x4x4_t p) {
+    float32x4_t sum = vmulq_f32(p.val[0], p.val[0]);
+    sum = vfmaq_f32(sum, p.val[1], p.val[1]);
+    sum = vfmaq_f32(sum, p.val[2], p.val[2]);
+    sum = vfmaq_f32(sum, p.val[3], p.val[3]);
+    return vsqrtq_f32(sum);
+}
+
+static int simd_norm_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    float* norms = (float*)out;
+    size_t i = 0;
+    (void)b;
+    
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(&norms[i], simd_norm4(vld4q_f32(&a[i].w)));
+    }
+    return autovec_norm_n(a + i, NULL, (quaternion_t*)(norms + i), count - i);
+}
+
+static inline int simd_normalize_body(const quaternion_t* a, quaternion_t* out, size_t count, int mode) {
+    float32x4_t eps = vdupq_n_f32(norm_epsilon);
+    float32x4_t one = vdupq_n_f32(1.0f);
+    uint32_t zero_found = 0;
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        if (mode & SIMD_STREAM) __builtin_prefetch(&a[i + SIMD_PREFETCH_AHEAD], 0, 0);
+        
+        float32x4x4_t p = vld4q_f32(&a[i].w);
+        float32x4_t norm = simd_norm4(p);
+        uint32x4_t zero = vcltq_f32(norm, eps);
+        float32x4_t divisor = vbslq_f32(zero, one, norm);
+        
+        for (int c = 0; c < 4; c++) p.val[c] = vdivq_f32(p.val[c], divisor);
+        if (mode & SIMD_STREAM) {
+            simd_stream4(&out[i], p);
+        } else {
+            vst4q_f32(&out[i].w, p);
+        }
+        zero_found |= vmaxvq_u32(zero);
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    int status = autovec_normalize_n(a + i, NULL, out + i, count - i);
+    return zero_found ? HC_ERROR_DIVIDE_ZERO : status;
+}
+
+#elif defined(HC_SIMD_SSE)
+
+// movntps needs an aligned destination; batch_select only streams to 16-byte aligned outputs
+#define SIMD_LOAD(p, mode) (((mode) & SIMD_ALIGNED) ? _mm_load_ps(p) : _mm_loadu_ps(p))
+#define SIMD_STORE(p, v, mode) (((mode) & SIMD_STREAM) ? _mm_stream_ps((p), (v)) \
+                                : ((mode) & SIMD_ALIGNED) ? _mm_store_ps((p), (v)) : _mm_storeu_ps((p), (v)))
+#define SIMD_PREFETCH(p, mode) (((mode) & SIMD_STREAM) ? _mm_prefetch((const char*)(p), _MM_HINT_NTA) : (void)0)
+
+// Four quaternions per step, transposed so each register holds one component
+static inline int simd_multiply_body(const quaternion_t* a, const quaternion_t* b, quaternion_t* out,
+                                     size_t count, int mode) {
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        SIMD_PREFETCH(&a[i + SIMD_PREFETCH_AHEAD], mode);
+        SIMD_PREFETCH(&b[i + SIMD_PREFETCH_AHEAD], mode);
+        
+        __m128 aw = SIMD_LOAD(&a[i].w, mode), ax = SIMD_LOAD(&a[i + 1].w, mode);
+        __m128 ay = SIMD_LOAD(&a[i + 2].w, mode), az = SIMD_LOAD(&a[i + 3].w, mode);
+        __m128 bw = SIMD_LOAD(&b[i].w, mode), bx = SIMD_LOAD(&b[i + 1].w, mode);
+        __m128 by = SIMD_LOAD(&b[i + 2].w, mode), bz = SIMD_LOAD(&b[i + 3].w, mode);
+        _MM_TRANSPOSE4_PS(aw, ax, ay, az);
+        _MM_TRANSPOSE4_PS(bw, bx, by, bz);
+        
+        __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)),
+                                          _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        __m128 rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)),
+                                          _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ax, bz)),
+                                          _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx));
+        __m128 rz = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(ax, by)),
+                                          _mm_mul_ps(ay, bx)), _mm_mul_ps(az, bw));
+        
+        _MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+        SIMD_STORE(&out[i].w, rw, mode);
+        SIMD_STORE(&out[i + 1].w, rx, mode);
+        SIMD_STORE(&out[i + 2].w, ry, mode);
+        SIMD_STORE(&out[i + 3].w, rz, mode);
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    return autovec_multiply_n(a + i, b + i, out + i, count - i);
+}
+
+static inline int simd_add_body(const quaternion_t* a, const quaternion_t* b, quaternion_t* out,
+                                size_t count, int mode) {
+    for (size_t i = 0; i < count; i++) {
+        if ((i & 3) == 0) {
+            SIMD_PREFETCH(&a[i + SIMD_PREFETCH_AHEAD], mode);
+            SIMD_PREFETCH(&b[i + SIMD_PREFETCH_AHEAD], mode);
+        }
+        SIMD_STORE(&out[i].w, _mm_add_ps(SIMD_LOAD(&a[i].w, mode), SIMD_LOAD(&b[i].w, mode)), mode);
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    return HC_SUCCESS;
+}
+
+static inline int simd_conjugate_body(const quaternion_t* a, quaternion_t* out, size_t count, int mode) {
+    __m128 mask = _mm_set_ps(-0.0f, -0.0f, -0.0f, 0.0f);
+    
+    for (size_t i = 0; i < count; i++) {
+        if ((i & 3) == 0) SIMD_PREFETCH(&a[i + SIMD_PREFETCH_AHEAD], mode);
+        SIMD_STORE(&out[i].w, _mm_xor_ps(SIMD_LOAD(&a[i].w, mode), mask), mode);
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    return HC_SUCCESS;
+}
+
+static inline __m128 simd_norm4(__m128 w, __m128 x, __m128 y, __m128 z) {
+    __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+                            _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+    return _mm_sqrt_ps(sum);
+}
+
+static int simd_norm_n(const quaternion_t* a, const quaternion_t* b, quaternion_t* out, size_t count) {
+    float* norms = (float*)out;
+    size_t i = 0;
+    (void)b;
+    
+    for (; i + 4 <= count; i += 4) {
+        __m128 w = _mm_loadu_ps(&a[i].w), x = _mm_loadu_ps(&a[i + 1].w);
+        __m128 y = _mm_loadu_ps(&a[i + 2].w), z = _mm_loadu_ps(&a[i + 3].w);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        _mm_storeu_ps(&norms[i], simd_norm4(w, x, y, z));
+    }
+    return autovec_norm_n(a + i, NULL, (quaternion_t*)(norms + i), count - i);
+}
+
+static inline int simd_normalize_body(const quaternion_t* a, quaternion_t* out, size_t count, int mode) {
+    __m128 eps = _mm_set1_ps(norm_epsilon);
+    __m128 one = _mm_set1_ps(1.0f);
+    int zero_found = 0;
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        SIMD_PREFETCH(&a[i + SIMD_PREFETCH_AHEAD], mode);
+        
+        __m128 w = SIMD_LOAD(&a[i].w, mode), x = SIMD_LOAD(&a[i + 1].w, mode);
+        __m128 y = SIMD_LOAD(&a[i + 2].w, mode), z = SIMD_LOAD(&a[i + 3].w, mode);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        
+        __m128 norm = simd_norm4(w, x, y, z);
+        __m128 zero = _mm_cmplt_ps(norm, eps);
+        zero_found |= _mm_movemask_ps(zero);
+        __m128 divisor = _mm_or_ps(_mm_and_ps(zero, one), _mm_andnot_ps(zero, norm));
+        
+        w = _mm_div_ps(w, divisor);
+        x = _mm_div_ps(x, divisor);
+        y = _mm_div_ps(y, divisor);
+        z = _mm_div_ps(z, divisor);
+        _MM_TRANSPOSE4_PS(w, x, y, z);
+        SIMD_STORE(&out[i].w, w, mode);
+        SIMD_STORE(&out[i + 1].w, x, mode);
+        SIMD_STORE(&out[i + 2].w, y, mode);
+        SIMD_STORE(&out[i + 3].w, z, mode);
+    }
+    
+    if (mode & SIMD_STREAM) stream_fence();
+    int status = autovec_normalize_n(a + i, NULL, out + i, count - i);
+    return zero_found ? HC_ERROR_DIVIDE_ZERO : status;
+}
+
+#endif /* HC_SIMD_NEON / HC_SIMD_SSE */
+
+#if defined(HC_SIMD_NEON) || defined(HC_SIMD_SSE)
+
+// One set of backend entry points per store mode
+#define SIMD_KERNELS(suffix, mode)                                                                   \
+static int simd_multiply##suffix(const quaternion_t* a, const quaternion_t* b,                      \
+                                 quaternion_t* out, size_t count) {                                 \
+    return simd_multiply_body(a, b, out, count, mode);                                              \
+}                                                                                                   \
+static int simd_add##suffix(const quaternion_t* a, const quaternion_t* b,                           \
+                            quaternion_t* out, size_t count) {                                      \
+    return simd_add_body(a, b, out, count, mode);                                                   \
+}                                                                                                   \
+static int simd_conjugate##suffix(const quaternion_t* a, const quaternion_t* b,                     \
+                                  quaternion_t* out, size_t count) {                                \
+    (void)b;                                                                                        \
+    return simd_conjugate_body(a, out, count, mode);                                                \
+}                                                                                                   \
+static int simd_normalize##suffix(const quaternion_t* a, const quaternion_t* b,                     \
+                                  quaternion_t* out, size_t count) {                                \
+    (void)b;                                                                                        \
+    return simd_normalize_body(a, out, count, mode);                                                \
+}
+
+SIMD_KERNELS(_n, 0)
+SIMD_KERNELS(_a16_n, SIMD_ALIGNED)
+SIMD_KERNELS(_nt_n, SIMD_STREAM)
+SIMD_KERNELS(_a16_nt_n, SIMD_ALIGNED | SIMD_STREAM)
+
+#endif
+
+static const backend_fn_t backend_table[HC_BACKEND_COUNT][HC_KERNEL_COUNT] = {
+    { scalar_multiply_n, scalar_add_n, scalar_conjugate_n, scalar_norm_n, scalar_normalize_n },
+#ifdef __aarch64__
+    { asm_multiply_n, asm_add_n, asm_conjugate_n, asm_norm_n, asm_normalize_n },
+#else
+    { NULL, NULL, NULL, NULL, NULL },
+#endif
+    { autovec_multiply_n, autovec_add_n, autovec_conjugate_n, autovec_norm_n, autovec_normalize_n },
+#if defined(HC_SIMD_NEON) || defined(HC_SIMD_SSE)
+    { simd_multiply_n, simd_add_n, simd_conjugate_n, simd_norm_n, simd_normalize_n },
+#else
+    { NULL, NULL, NULL, NULL, NULL },
+#endif
+};
+
+// Kernels for the *_aligned entry points, then the streaming-store kernels for
+// outputs past nt_threshold_bytes, indexed [aligned]. Builds without SIMD never stream.
+static const backend_fn_t aligned_table[HC_KERNEL_COUNT] = {
+#if defined(HC_SIMD_NEON) || defined(HC_SIMD_SSE)
+    simd_multiply_a16_n, simd_add_a16_n, simd_conjugate_a16_n, simd_norm_n, simd_normalize_a16_n
+#else
+    autovec_multiply_n, autovec_add_n, autovec_conjugate_n, autovec_norm_n, autovec_normalize_n
+#endif
+};
+
+#if defined(HC_SIMD_NEON) || defined(HC_SIMD_SSE)
+static const backend_fn_t stream_table[2][HC_KERNEL_COUNT] = {
+    { simd_multiply_nt_n, simd_add_nt_n, simd_conjugate_nt_n, simd_norm_n, simd_normalize_nt_n },
+    { simd_multiply_a16_nt_n, simd_add_a16_nt_n, simd_conjugate_a16_nt_n, simd_norm_n, simd_normalize_a16_nt_n },
+};
+#endif
+
+
+const char* hc_backend_name(hc_backend_t backend) {
+    switch (backend) {
+    case HC_BACKEND_SCALAR: return "scalar";
+    case HC_BACKEND_ASM: return "asm";
+    case HC_BACKEND_AUTOVEC: return "autovec";
+#if defined(HC_SIMD_NEON)
+    case HC_BACKEND_SIMD: return "neon";
+#elif defined(HC_SIMD_SSE)
+    case HC_BACKEND_SIMD: return "sse";
+#else
+    case HC_BACKEND_SIMD: return "simd";
+#endif
+    default: return "unknown";
+    }
+}
+
+const char* hc_kernel_name(hc_kernel_t kernel) {
+    static const char* const names[HC_KERNEL_COUNT] = {
+        "multiply", "add", "conjugate", "norm", "normalize"
+    };
+    
+    if ((unsigned)kernel >= HC_KERNEL_COUNT) return "unknown";
+    return names[kernel];
+}
+
+int hc_backend_available(hc_backend_t backend) {
+    return (unsigned)backend < HC_BACKEND_COUNT && backend_table[backend][0] != NULL;
+}
+
+/*
+ * Tuning
+ */
+
+// Published through a seqlock: setters are serialized by the mutex, and readers
+// copy the fields and retry if a setter ran meanwhile, so no call sees a mix
+static struct {
+    pthread_mutex_t write;
+    _Atomic unsigned sequence;               // Odd while a setter is storing
+    _Atomic int batch_backend;
+    _Atomic size_t chunk_elements;
+    _Atomic unsigned threads;
+    _Atomic size_t nt_threshold_bytes;
+} tuning = { .write = PTHREAD_MUTEX_INITIALIZER };
+static pthread_once_t tuning_once = PTHREAD_ONCE_INIT;
+
+void hc_tuning_default(hc_tuning_t* t) {
+    if (!t) return;
+    
+    t->batch_backend = HC_BACKEND_AUTOVEC;
+    t->chunk_elements = 16384;
+    t->threads = 1;
+    t->nt_threshold_bytes = 0;
+}
+
+static int tuning_valid(const hc_tuning_t* t) {
+    return t->batch_backend != HC_BACKEND_SCALAR && hc_backend_available(t->batch_backend) &&
+           t->chunk_elements > 0 && t->threads >= 1 && t->threads <= HC_MAX_THREADS;
+}
+
+static int tuning_read(const char* path, hc_tuning_t* t);
+
+static void tuning_publish(const hc_tuning_t* t) {
+    pthread_mutex_lock(&tuning.write);
+    unsigned sequence = atomic_load_explicit(&tuning.sequence, memory_order_relaxed);
+    atomic_store_explicit(&tuning.sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    atomic_store_explicit(&tuning.batch_backend, (int)t->batch_backend, memory_order_relaxed);
+    atomic_store_explicit(&tuning.chunk_elements, t->chunk_elements, memory_order_relaxed);
+    atomic_store_explicit(&tuning.threads, t->threads, memory_order_relaxed);
+    atomic_store_explicit(&tuning.nt_threshold_bytes, t->nt_threshold_bytes, memory_order_relaxed);
+    
+    atomic_store_explicit(&tuning.sequence, sequence + 2, memory_order_release);
+    pthread_mutex_unlock(&tuning.write);
+}
+
+// The host's tuning file, if any, is read once before the first tuned call
+static void tuning_init(void) {
+    hc_tuning_t t;
+    
+    if (tuning_read(NULL, &t) != HC_SUCCESS) hc_tuning_default(&t);
+    tuning_publish(&t);
+}
+
+// Tuned calls take one copy on entry and use it throughout
+static void tuning_snapshot(hc_tuning_t* t) {
+    pthread_once(&tuning_once, tuning_init);
+    
+    for (;;) {
+        unsigned before = atomic_load_explicit(&tuning.sequence, memory_order_acquire);
+        if (before & 1) continue;
+        
+        t->batch_backend = (hc_backend_t)atomic_load_explicit(&tuning.batch_backend, memory_order_relaxed);
+        t->chunk_elements = atomic_load_explicit(&tuning.chunk_elements, memory_order_relaxed);
+        t->threads = atomic_load_explicit(&tuning.threads, memory_order_relaxed);
+        t->nt_threshold_bytes = atomic_load_explicit(&tuning.nt_threshold_bytes, memory_order_relaxed);
+        
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&tuning.sequence, memory_order_relaxed) == before) return;
+    }
+}
+
+int hc_tuning_get(hc_tuning_t* t) {
+    if (!t) return HC_ERROR_NULL_PTR;
+    
+    tuning_snapshot(t);
+    return HC_SUCCESS;
+}
+
+int hc_tuning_set(const hc_tuning_t* t) {
+    if (!t) return HC_ERROR_NULL_PTR;
+    if (!tuning_valid(t)) return HC_ERROR_INVALID_DATA;
+    
+    pthread_once(&tuning_once, tuning_init);
+    tuning_publish(t);
+    return HC_SUCCESS;
+}
+
+int hc_tuning_path(char* path, size_t size) {
+    if (!path || size == 0) return HC_ERROR_NULL_PTR;
+    
+    const char* file = getenv("HC_TUNING_FILE");
+    if (file && *file) {
+        return (size_t)snprintf(path, size, "%s", file) < size ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+    }
+    
+    const char* config = getenv("XDG_CONFIG_HOME");
+    const char* home = getenv("HOME");
+    char host[64] = "localhost";
+    gethostname(host, sizeof(host) - 1);
+    
+    int n = (config && *config) ? snprintf(path, size, "%s/hypercomplex/%s.conf", config, host)
+          : (home && *home) ? snprintf(path, size, "%s/.config/hypercomplex/%s.conf", home, host)
+          : -1;
+    return (n >= 0 && (size_t)n < size) ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+}
+
+// Parses a tuning file into t; nothing is applied
+static int tuning_read(const char* path, hc_tuning_t* t) {
+    char default_path[512];
+    if (!path) {
+        if (hc_tuning_path(default_path, sizeof(default_path)) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+        path = default_path;
+    }
+    
+    FILE* in = fopen(path, "r");
+    if (!in) return HC_ERROR_INVALID_DATA;
+    
+    hc_tuning_default(t);
+    
+    // "key = value" lines; '#' comments and unknown keys are skipped
+    char line[256], key[64], value[64];
+    while (fgets(line, sizeof(line), in)) {
+        if (line[0] == '#' || sscanf(line, " %63[a-z_] = %63s", key, value) != 2) continue;
+        
+        if (strcmp(key, "batch_backend") == 0) {
+            for (int b = 0; b < HC_BACKEND_COUNT; b++) {
+                if (strcmp(value, hc_backend_name((hc_backend_t)b)) == 0) t->batch_backend = (hc_backend_t)b;
+            }
+        } else if (strcmp(key, "chunk_elements") == 0) {
+            t->chunk_elements = strtoull(value, NULL, 10);
+        } else if (strcmp(key, "threads") == 0) {
+            t->threads = (unsigned)strtoul(value, NULL, 10);
+        } else if (strcmp(key, "nt_threshold_bytes") == 0) {
+            t->nt_threshold_bytes = strtoull(value, NULL, 10);
+        }
+    }
+    fclose(in);
+    
+    // A file from another build (say, naming a backend this one lacks) is rejected whole
+    return tuning_valid(t) ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+}
+
+int hc_tuning_load(const char* path) {
+    hc_tuning_t t;
+    
+    pthread_once(&tuning_once, tuning_init);
+    if (tuning_read(path, &t) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+    
+    tuning_publish(&t);
+    return HC_SUCCESS;
+}
+
+int hc_tuning_save(const char* path, const hc_tuning_t* t) {
+    if (!t) return HC_ERROR_NULL_PTR;
+    if (!tuning_valid(t)) return HC_ERROR_INVALID_DATA;
+    
+    char default_path[512];
+    if (!path) {
+        if (hc_tuning_path(default_path, sizeof(default_path)) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+        path = default_path;
+        
+        // Create the hypercomplex/ directory and its parent when they are missing
+        char dir[512];
+        snprintf(dir, sizeof(dir), "%s", path);
+        for (char* slash = strchr(dir + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+            *slash = '\0';
+            mkdir(dir, 0755);
+            *slash = '/';
+        }
+    }
+    
+    FILE* out = fopen(path, "w");
+    if (!out) return HC_ERROR_INVALID_DATA;
+    
+    char host[64] = "localhost";
+    gethostname(host, sizeof(host) - 1);
+    
+    fprintf(out, "# hypercomplex tuning for %s, written by hc_autotune\n", host);
+    fprintf(out, "batch_backend = %s\n", hc_backend_name(t->batch_backend));
+    fprintf(out, "chunk_elements = %zu\n", t->chunk_elements);
+    fprintf(out, "threads = %u\n", t->threads);
+    fprintf(out, "nt_threshold_bytes = %zu\n", t->nt_threshold_bytes);
+    
+    return fclose(out) == 0 ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+}
+
+/*
+ * Worker pool
+ */
+
+#define POOL_MAX_WORKERS (HC_MAX_THREADS - 1)
+
+// Processes elements [begin, end) of one split call
+typedef int (*pool_fn_t)(void* ctx, size_t begin, size_t end);
+
+static struct {
+    pthread_mutex_t submit;                  // One split call at a time; others run inline
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned workers;                        // Started so far, never stopped
+    unsigned active;                         // Workers taking part in the current call
+    unsigned pending;                        // Of those, how many are still running
+    uint64_t generation;
+    uint64_t seen[POOL_MAX_WORKERS];         // Last generation each worker picked up
+    pool_fn_t fn;
+    void* ctx;
+    size_t count;
+    size_t chunk;
+    _Atomic size_t next;
+    _Atomic int status;
+    pthread_cond_t task_wake;
+    hc_task_t* task_head;                    // hc_task_submit queue, oldest first
+    hc_task_t* task_tail;
+    unsigned task_workers;                   // Threads serving the queue, never stopped
+    unsigned task_idle;                      // Of those, how many are waiting for a task
+} pool = { .submit = PTHREAD_MUTEX_INITIALIZER, .lock = PTHREAD_MUTEX_INITIALIZER,
+           .wake = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER,
+           .task_wake = PTHREAD_COND_INITIALIZER };
+
+static void pool_run_chunks(void) {
+    for (;;) {
+        size_t begin = atomic_fetch_add_explicit(&pool.next, pool.chunk, memory_order_relaxed);
+        if (begin >= pool.count) break;
+        
+        size_t end = (pool.count - begin > pool.chunk) ? begin + pool.chunk : pool.count;
+        int status = pool.fn(pool.ctx, begin, end);
+        if (status != HC_SUCCESS) atomic_store_explicit(&pool.status, status, memory_order_relaxed);
+    }
+}
+
+static void* pool_worker(void* arg) {
+    unsigned index = (unsigned)(uintptr_t)arg;
+    
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (pool.generation == pool.seen[index]) pthread_cond_wait(&pool.wake, &pool.lock);
+        pool.seen[index] = pool.generation;
+        if (index >= pool.active) continue;
+        
+        pthread_mutex_unlock(&pool.lock);
+        pool_run_chunks();
+        pthread_mutex_lock(&pool.lock);
+        
+        if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+    }
+    
+    return NULL;
+}
+
+// Splits [0, count) into chunks shared by the caller and up to threads - 1 workers
+static int pool_run(pool_fn_t fn, void* ctx, size_t count, size_t chunk, unsigned threads) {
+    size_t chunks = (count + chunk - 1) / chunk;
+    unsigned helpers = threads - 1;
+    if (helpers > POOL_MAX_WORKERS) helpers = POOL_MAX_WORKERS;
+    if (helpers > chunks - 1) helpers = (unsigned)(chunks - 1);
+    
+    if (helpers == 0 || pthread_mutex_trylock(&pool.submit) != 0) return fn(ctx, 0, count);
+    
+    pthread_mutex_lock(&pool.lock);
+    while (pool.workers < helpers) {
+        pthread_t thread;
+        pool.seen[pool.workers] = pool.generation;
+        if (pthread_create(&thread, NULL, pool_worker, (void*)(uintptr_t)pool.workers) != 0) break;
+        pthread_detach(thread);
+        pool.workers++;
+    }
+    if (helpers > pool.workers) helpers = pool.workers;
+    
+    pool.fn = fn;
+    pool.ctx = ctx;
+    pool.count = count;
+    pool.chunk = chunk;
+    atomic_store(&pool.next, 0);
+    atomic_store(&pool.status, HC_SUCCESS);
+    pool.active = helpers;
+    pool.pending = helpers;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+    
+    pool_run_chunks();
+    
+    pthread_mutex_lock(&pool.lock);
+    while (pool.pending > 0) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+    
+    int status = atomic_load(&pool.status);
+    pthread_mutex_unlock(&pool.submit);
+    return status;
+}
+
+// Task threads are separate from the split-call workers, so a long task never
+// holds up a split call; a task may itself make split calls
+static void* pool_task_worker(void* arg) {
+    (void)arg;
+    
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (!pool.task_head) {
+            pool.task_idle++;
+            pthread_cond_wait(&pool.task_wake, &pool.lock);
+            pool.task_idle--;
+        }
+        
+        hc_task_t* task = pool.task_head;
+        pool.task_head = task->next;
+        if (!pool.task_head) pool.task_tail = NULL;
+        pthread_mutex_unlock(&pool.lock);
+        
+        // The task may be freed or reused as soon as done returns
+        int status = task->run(task);
+        if (task->done) task->done(task, status);
+        
+        pthread_mutex_lock(&pool.lock);
+    }
+    
+    return NULL;
+}
+
+int hc_task_submit(hc_task_t* task) {
+    if (!task || !task->run) return HC_ERROR_NULL_PTR;
+    
+    hc_tuning_t tuned;
+    tuning_snapshot(&tuned);
+    
+    unsigned limit = tuned.threads;
+    if (limit < 1) limit = 1;
+    
+    pthread_mutex_lock(&pool.lock);
+    if (pool.task_idle == 0 && pool.task_workers < limit) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, pool_task_worker, NULL) == 0) {
+            pthread_detach(thread);
+            pool.task_workers++;
+        }
+    }
+    if (pool.task_workers == 0) {
+        pthread_mutex_unlock(&pool.lock);
+        return HC_ERROR_NO_MEMORY;
+    }
+    
+    task->next = NULL;
+    if (pool.task_tail) {
+        pool.task_tail->next = task;
+    } else {
+        pool.task_head = task;
+    }
+    pool.task_tail = task;
+    pthread_cond_signal(&pool.task_wake);
+    pthread_mutex_unlock(&pool.lock);
+    return HC_SUCCESS;
+}
+
+int quaternion_is_valid(const quaternion_t* q) {
+    if (!q) return 0;
+    
+    return (isfinite(q->w) && isfinite(q->x) && 
+            isfinite(q->y) && isfinite(q->z));
+}
+
+static void generate_key_impl(quaternion_t* key, uint64_t seed) {
+    if (!key) return;
+    
+    // Simple PRNG based on seed
+    uint64_t state = seed;
+    
+    // Linear congruential generator
+    state = state * 1103515245 + 12345;
+    key->w = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    
+    state = state * 1103515245 + 12345;
+    key->x = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    
+    state = state * 1103515245 + 12345;
+    key->y = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    
+    state = state * 1103515245 + 12345;
+    key->z = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    
+    // Normalize the key
+    quaternion_normalize(key, key);
+}
+
+void quaternion_generate_key(quaternion_t* key, uint64_t seed) {
+    uint64_t start = stats_begin();
+    generate_key_impl(key, seed);
+    stats_end(HC_API_GENERATE_KEY, sizeof(quaternion_t), key ? HC_SUCCESS : HC_ERROR_NULL_PTR, start);
+}
+
+static uint32_t compute_checksum(const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t checksum = 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        checksum = (checksum << 1) ^ bytes[i];
+    }
+    
+    return checksum;
+}
+
+// Each ciphertext block carries 8 message bytes as four 16-bit words widened to
+// floats. Block norms stay below 2^16, so the rounding of the transform and its
+// inverse is far under half a unit and decryption recovers every word exactly.
+#define CIPHER_BLOCK_BYTES 8
+
+static inline void widen_block(const uint8_t* src, size_t avail, quaternion_t* q) {
+    int16_t words[4] = { 0, 0, 0, 0 };
+    memcpy(words, src, avail < sizeof(words) ? avail : sizeof(words));
+    quaternion_init(q, words[0], words[1], words[2], words[3]);
+}
+
+static inline void narrow_block(const quaternion_t* q, uint8_t* dst, size_t avail) {
+    int16_t words[4] = { (int16_t)lrintf(q->w), (int16_t)lrintf(q->x),
+                         (int16_t)lrintf(q->y), (int16_t)lrintf(q->z) };
+    memcpy(dst, words, avail < sizeof(words) ? avail : sizeof(words));
+}
+
+typedef struct {
+    uint8_t* data;
+    const quaternion_t* key;
+} encrypt_ctx_t;
+
+typedef struct {
+    const uint8_t* plaintext;
+    uint8_t* data;
+    size_t length;
+    const quaternion_t* key;
+} encrypt_stream_ctx_t;
+
+// Ciphertext blocks sit after the header and are only 8-byte aligned, so they
+// are streamed as two 64-bit halves (movnti / stnp of general registers)
+static inline void stream_quaternion(quaternion_t* dst, const quaternion_t* q) {
+    uint64_t half[2];
+    memcpy(half, q, sizeof(half));
+#if defined(HC_SIMD_SSE) && defined(__x86_64__)
+    _mm_stream_si64((long long*)dst, (long long)half[0]);
+    _mm_stream_si64((long long*)dst + 1, (long long)half[1]);
+#elif defined(__aarch64__)
+    __asm__ volatile("stnp %1, %2, [%0]" : : "r"(dst), "r"(half[0]), "r"(half[1]) : "memory");
+#else
+    memcpy(dst, half, sizeof(half));
+#endif
+}
+
+// Widen, pad and transform in one pass: plaintext is read once and the
+// ciphertext written around the cache instead of widened and then rewritten
+static int encrypt_stream_chunk(void* arg, size_t begin, size_t end) {
+    encrypt_stream_ctx_t* c = (encrypt_stream_ctx_t*)arg;
+    quaternion_t block, temp, out;
+    
+    for (size_t i = begin; i < end; i++) {
+        size_t offset = i * CIPHER_BLOCK_BYTES;
+        
+        __builtin_prefetch(c->plaintext + offset + 512, 0, 0);
+        widen_block(c->plaintext + offset, c->length - offset, &block);
+        quaternion_multiply(&block, c->key, &temp);
+        quaternion_conjugate(&temp, &out);
+        stream_quaternion((quaternion_t*)(c->data + i * sizeof(quaternion_t)), &out);
+    }
+    
+    stream_fence();
+    return HC_SUCCESS;
+}
+
+// hypercomplex_encrypt's transform with a local temporary, so chunks can run concurrently
+static int encrypt_chunk(void* arg, size_t begin, size_t end) {
+    encrypt_ctx_t* c = (encrypt_ctx_t*)arg;
+    quaternion_t temp;
+    
+    for (size_t i = begin; i < end; i++) {
+        quaternion_t* block = (quaternion_t*)(c->data + i * sizeof(quaternion_t));
+        quaternion_multiply(block, c->key, &temp);
+        quaternion_conjugate(&temp, block);
+    }
+    
+    return HC_SUCCESS;
+}
+
+static int encrypt_data_impl(const void* plaintext, size_t length,
+                             const quaternion_t* key, void* ciphertext,
+                             size_t* cipher_length) {
+    if (!plaintext || !key || !ciphertext || !cipher_length) {
+        return HC_ERROR_NULL_PTR;
+    }
+    
+    if (!quaternion_is_valid(key)) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    // Calculate required cipher length
+    size_t header_size = sizeof(hypercomplex_header_t);
+    size_t total_size = hypercomplex_cipher_length(length);
+    size_t data_size = total_size - header_size;
+    
+    if (*cipher_length < total_size) {
+        *cipher_length = total_size;
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    // Create header
+    hypercomplex_header_t* header = (hypercomplex_header_t*)ciphertext;
+    header->magic = 0xDEADBEEF;
+    header->length = length;
+    header->key = *key;
+    HC_PROBE1(checksum_start, length);
+    header->checksum = compute_checksum(plaintext, length);
+    HC_PROBE1(checksum_done, length);
+    
+    uint8_t* padded_data = (uint8_t*)ciphertext + header_size;
+    hc_tuning_t tuned;
+    tuning_snapshot(&tuned);
+    size_t blocks = data_size / sizeof(quaternion_t);
+    int split = tuned.threads > 1 && blocks >= 2 * tuned.chunk_elements;
+    int result;
+    
+    // Ciphertexts past nt_threshold_bytes are widened and transformed in one streaming pass
+    if (tuned.nt_threshold_bytes && data_size >= tuned.nt_threshold_bytes) {
+        encrypt_stream_ctx_t ctx = { (const uint8_t*)plaintext, padded_data, length, key };
+        
+        HC_PROBE1(transform_start, blocks);
+        result = split ? pool_run(encrypt_stream_chunk, &ctx, blocks, tuned.chunk_elements, tuned.threads)
+                       : encrypt_stream_chunk(&ctx, 0, blocks);
+        HC_PROBE2(transform_done, blocks, result);
+    } else {
+        // Widen the plaintext into the ciphertext blocks, zero-padding the last one
+        HC_PROBE1(copy_start, length);
+        quaternion_t* widened = (quaternion_t*)padded_data;
+        for (size_t i = 0; i < blocks; i++) {
+            widen_block((const uint8_t*)plaintext + i * CIPHER_BLOCK_BYTES, length - i * CIPHER_BLOCK_BYTES,
+                        &widened[i]);
+        }
+        HC_PROBE1(copy_done, length);
+        
+        // Encrypt the data; large messages are split across the worker pool when tuned to
+        HC_PROBE1(transform_start, blocks);
+        if (split) {
+            encrypt_ctx_t ctx = { padded_data, key };
+            result = pool_run(encrypt_chunk, &ctx, blocks, tuned.chunk_elements, tuned.threads);
+        } else {
+            result = hypercomplex_encrypt(padded_data, key, padded_data, data_size);
+        }
+        HC_PROBE2(transform_done, blocks, result);
+    }
+    
+    if (result == HC_SUCCESS) {
+        *cipher_length = total_size;
+    }
+    
+    return result;
+}
+
+int hypercomplex_encrypt_data(const void* plaintext, size_t length, 
+                             const quaternion_t* key, void* ciphertext, 
+                             size_t* cipher_length) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(encrypt_entry, plaintext, length);
+    int result = encrypt_data_impl(plaintext, length, key, ciphertext, cipher_length);
+    HC_PROBE2(encrypt_return, length, result);
+    stats_end(HC_API_ENCRYPT_DATA, length, result, start);
+    return result;
+}
+
+#define DECRYPT_BATCH 256
+
+static int batch_dispatch_tuned(const hc_tuning_t* t, hc_kernel_t kernel, const quaternion_t* a,
+                                const quaternion_t* b, quaternion_t* out, size_t count);
+
+typedef struct {
+    const quaternion_t* data;
+    uint8_t* plaintext;
+    size_t length;
+    quaternion_t key;
+    const hc_tuning_t* tuning;
+} decrypt_ctx_t;
+
+// Runs the inverse through the batch kernels a stack buffer at a time: multiply
+// by the broadcast key, conjugate, then narrow each block back to its 8 bytes
+static int decrypt_chunk(void* arg, size_t begin, size_t end) {
+    decrypt_ctx_t* c = (decrypt_ctx_t*)arg;
+    quaternion_t keys[DECRYPT_BATCH], blocks[DECRYPT_BATCH];
+    hc_tuning_t local = *c->tuning;
+    int result = HC_SUCCESS;
+    
+    // The buffer is read straight back, so it stays in cache and on this thread
+    local.threads = 1;
+    local.nt_threshold_bytes = 0;
+    for (size_t i = 0; i < DECRYPT_BATCH && i < end - begin; i++) keys[i] = c->key;
+    
+    for (size_t i = begin; i < end && result == HC_SUCCESS; i += DECRYPT_BATCH) {
+        size_t n = end - i < DECRYPT_BATCH ? end - i : DECRYPT_BATCH;
+        
+        result = batch_dispatch_tuned(&local, HC_KERNEL_MULTIPLY, keys, c->data + i, blocks, n);
+        if (result == HC_SUCCESS) result = batch_dispatch_tuned(&local, HC_KERNEL_CONJUGATE, blocks, NULL, blocks, n);
+        for (size_t j = 0; result == HC_SUCCESS && j < n; j++) {
+            size_t offset = (i + j) * CIPHER_BLOCK_BYTES;
+            narrow_block(&blocks[j], c->plaintext + offset, c->length - offset);
+        }
+    }
+    
+    return result;
+}
+
+static int decrypt_data_impl(const void* ciphertext, size_t cipher_length,
+                             const quaternion_t* key, void* plaintext,
+                             size_t* plain_length) {
+    if (!ciphertext || !key || !plaintext || !plain_length) {
+        return HC_ERROR_NULL_PTR;
+    }
+    
+    if (cipher_length < sizeof(hypercomplex_header_t)) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    // Validate header
+    const hypercomplex_header_t* header = (const hypercomplex_header_t*)ciphertext;
+    if (header->magic != 0xDEADBEEF) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    if (*plain_length < header->length) {
+        *plain_length = header->length;
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    size_t blocks = (header->length + CIPHER_BLOCK_BYTES - 1) / CIPHER_BLOCK_BYTES;
+    if (cipher_length - sizeof(hypercomplex_header_t) < blocks * sizeof(quaternion_t)) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    // Encryption stores c = conj(v k), so v = conj(k' c) with k' = conj(k^-1)
+    quaternion_t inv_key;
+    int result = quaternion_inverse(&header->key, &inv_key);
+    
+    if (result == HC_SUCCESS) {
+        const uint8_t* data = (const uint8_t*)ciphertext + sizeof(hypercomplex_header_t);
+        hc_tuning_t tuned;
+        tuning_snapshot(&tuned);
+        decrypt_ctx_t ctx = { (const quaternion_t*)data, (uint8_t*)plaintext, header->length, inv_key, &tuned };
+        scalar_conjugate(&inv_key, &ctx.key);
+        
+        HC_PROBE1(transform_start, blocks);
+        result = tuned.threads > 1 && blocks >= 2 * tuned.chunk_elements
+                     ? pool_run(decrypt_chunk, &ctx, blocks, tuned.chunk_elements, tuned.threads)
+                     : decrypt_chunk(&ctx, 0, blocks);
+        HC_PROBE2(transform_done, blocks, result);
+    }
+    
+    if (result == HC_SUCCESS) {
+        *plain_length = header->length;
+        
+        // Verify checksum
+        HC_PROBE1(checksum_start, header->length);
+        uint32_t checksum = compute_checksum(plaintext, header->length);
+        HC_PROBE1(checksum_done, header->length);
+        if (checksum != header->checksum) {
+            return HC_ERROR_INVALID_DATA;
+        }
+    }
+    
+    return result;
+}
+
+int hypercomplex_decrypt_data(const void* ciphertext, size_t cipher_length,
+                             const quaternion_t* key, void* plaintext,
+                             size_t* plain_length) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(decrypt_entry, ciphertext, cipher_length);
+    int result = decrypt_data_impl(ciphertext, cipher_length, key, plaintext, plain_length);
+    HC_PROBE2(decrypt_return, cipher_length, result);
+    stats_end(HC_API_DECRYPT_DATA, cipher_length, result, start);
+    return result;
+}
+
+/*
+ * Batch operations
+ */
+
+typedef struct {
+    backend_fn_t fn;
+    const quaternion_t* a;
+    const quaternion_t* b;
+    quaternion_t* out;
+} batch_ctx_t;
+
+static int batch_chunk(void* arg, size_t begin, size_t end) {
+    batch_ctx_t* c = (batch_ctx_t*)arg;
+    return c->fn(c->a + begin, c->b ? c->b + begin : NULL, c->out + begin, end - begin);
+}
+
+// Splits a call across the pool when it is large enough; chunks start on element boundaries
+static int batch_run(const hc_tuning_t* t, backend_fn_t fn, const quaternion_t* a, const quaternion_t* b,
+                     quaternion_t* out, size_t count) {
+    batch_ctx_t ctx = { fn, a, b, out };
+    
+    if (t->threads <= 1 || count < 2 * t->chunk_elements) return fn(a, b, out, count);
+    return pool_run(batch_chunk, &ctx, count, t->chunk_elements, t->threads);
+}
+
+// Outputs of at least nt_threshold_bytes bypass the cache through the streaming
+// SIMD kernels, whichever backend is tuned; movntps also needs a 16-byte aligned output
+static backend_fn_t batch_stream_kernel(const hc_tuning_t* t, hc_kernel_t kernel, const quaternion_t* out,
+                                        size_t count, int aligned) {
+    size_t threshold = t->nt_threshold_bytes;
+    
+    if (threshold == 0 || count < threshold / sizeof(quaternion_t)) return NULL;
+#if defined(HC_SIMD_SSE)
+    if ((uintptr_t)out & 15) return NULL;
+    return stream_table[aligned][kernel];
+#elif defined(HC_SIMD_NEON)
+    (void)out;
+    return stream_table[aligned][kernel];
+#else
+    (void)kernel; (void)out; (void)aligned;
+    return NULL;
+#endif
+}
+
+// Runs a kernel under the given tuning
+static int batch_dispatch_tuned(const hc_tuning_t* t, hc_kernel_t kernel, const quaternion_t* a,
+                                const quaternion_t* b, quaternion_t* out, size_t count) {
+    backend_fn_t fn = batch_stream_kernel(t, kernel, out, count, 0);
+    if (!fn) fn = backend_table[t->batch_backend][kernel];
+    return batch_run(t, fn, a, b, out, count);
+}
+
+// Runs a kernel on the tuned backend
+static int batch_dispatch(hc_kernel_t kernel, const quaternion_t* a, const quaternion_t* b,
+                          quaternion_t* out, size_t count) {
+    hc_tuning_t t;
+    tuning_snapshot(&t);
+    return batch_dispatch_tuned(&t, kernel, a, b, out, count);
+}
+
+// Runs an aligned kernel after checking the alignment it relies on
+static int batch_dispatch_aligned(hc_kernel_t kernel, const quaternion_a16_t* a, const quaternion_a16_t* b,
+                                  quaternion_a16_t* out, size_t count) {
+    if (((uintptr_t)a | (uintptr_t)b | (uintptr_t)out) & (_Alignof(quaternion_a16_t) - 1)) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    hc_tuning_t t;
+    tuning_snapshot(&t);
+    backend_fn_t fn = batch_stream_kernel(&t, kernel, (const quaternion_t*)out, count, 1);
+    if (!fn) fn = aligned_table[kernel];
+    return batch_run(&t, fn, (const quaternion_t*)a, (const quaternion_t*)b, (quaternion_t*)out, count);
+}
+
+int quaternion_multiply_batch(const quaternion_t* q1, const quaternion_t* q2,
+                              quaternion_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_MULTIPLY, count);
+    int status = (!q1 || !q2 || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch(HC_KERNEL_MULTIPLY, q1, q2, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_MULTIPLY, count, status);
+    stats_end(HC_API_MULTIPLY_BATCH, 2 * count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_add_batch(const quaternion_t* q1, const quaternion_t* q2,
+                         quaternion_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_ADD, count);
+    int status = (!q1 || !q2 || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch(HC_KERNEL_ADD, q1, q2, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_ADD, count, status);
+    stats_end(HC_API_ADD_BATCH, 2 * count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_conjugate_batch(const quaternion_t* input, quaternion_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_CONJUGATE, count);
+    int status = (!input || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch(HC_KERNEL_CONJUGATE, input, NULL, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_CONJUGATE, count, status);
+    stats_end(HC_API_CONJUGATE_BATCH, count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_normalize_batch(const quaternion_t* input, quaternion_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_NORMALIZE, count);
+    int status = (!input || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch(HC_KERNEL_NORMALIZE, input, NULL, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_NORMALIZE, count, status);
+    stats_end(HC_API_NORMALIZE_BATCH, count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+/*
+ * Reductions
+ */
+
+#define REDUCE_MAX_PARTS 64
+
+typedef struct {
+    const quaternion_t* q;
+    size_t chunk;
+    int product;
+    quaternion_t parts[REDUCE_MAX_PARTS];    // One per chunk, combined in order afterwards
+} reduce_ctx_t;
+
+// Four running sums, one per quaternion of each group, so the adds don't wait on each other
+static quaternion_t reduce_sum_n(const quaternion_t* q, size_t count) {
+    quaternion_t acc[4] = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        for (int k = 0; k < 4; k++) {
+            acc[k].w += q[i + k].w;
+            acc[k].x += q[i + k].x;
+            acc[k].y += q[i + k].y;
+            acc[k].z += q[i + k].z;
+        }
+    }
+    for (; i < count; i++) autovec_add_n(&acc[0], &q[i], &acc[0], 1);
+    
+    autovec_add_n(&acc[0], &acc[1], &acc[0], 1);
+    autovec_add_n(&acc[2], &acc[3], &acc[2], 1);
+    autovec_add_n(&acc[0], &acc[2], &acc[0], 1);
+    return acc[0];
+}
+
+// Four contiguous quarters multiplied side by side so their chains overlap; order is kept
+static quaternion_t reduce_product_n(const quaternion_t* q, size_t count) {
+    quaternion_t acc[4];
+    size_t quarter = count / 4;
+    
+    for (int k = 0; k < 4; k++) quaternion_identity(&acc[k]);
+    for (size_t i = 0; i < quarter; i++) {
+        for (int k = 0; k < 4; k++) autovec_multiply_n(&acc[k], &q[k * quarter + i], &acc[k], 1);
+    }
+    for (size_t i = 4 * quarter; i < count; i++) autovec_multiply_n(&acc[3], &q[i], &acc[3], 1);
+    
+    autovec_multiply_n(&acc[0], &acc[1], &acc[0], 1);
+    autovec_multiply_n(&acc[2], &acc[3], &acc[2], 1);
+    autovec_multiply_n(&acc[0], &acc[2], &acc[0], 1);
+    return acc[0];
+}
+
+static int reduce_chunk(void* arg, size_t begin, size_t end) {
+    reduce_ctx_t* c = (reduce_ctx_t*)arg;
+    const quaternion_t* q = c->q + begin;
+    
+    c->parts[begin / c->chunk] = c->product ? reduce_product_n(q, end - begin) : reduce_sum_n(q, end - begin);
+    return HC_SUCCESS;
+}
+
+static int reduce_dispatch(const quaternion_t* q, size_t count, int product, quaternion_t* result) {
+    hc_tuning_t t;
+    tuning_snapshot(&t);
+    
+    if (t.threads <= 1 || count < 2 * t.chunk_elements) {
+        *result = product ? reduce_product_n(q, count) : reduce_sum_n(q, count);
+        return HC_SUCCESS;
+    }
+    
+    // Chunks grow past the tuned size when needed to stay within REDUCE_MAX_PARTS
+    reduce_ctx_t ctx;
+    ctx.q = q;
+    ctx.product = product;
+    ctx.chunk = t.chunk_elements;
+    if (count > ctx.chunk * REDUCE_MAX_PARTS) ctx.chunk = (count + REDUCE_MAX_PARTS - 1) / REDUCE_MAX_PARTS;
+    
+    // A busy pool runs the whole call as one chunk; the untouched parts stay neutral
+    size_t parts = (count + ctx.chunk - 1) / ctx.chunk;
+    for (size_t p = 0; p < parts; p++) {
+        if (product) {
+            quaternion_identity(&ctx.parts[p]);
+        } else {
+            quaternion_init(&ctx.parts[p], 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    
+    int status = pool_run(reduce_chunk, &ctx, count, ctx.chunk, t.threads);
+    *result = product ? reduce_product_n(ctx.parts, parts) : reduce_sum_n(ctx.parts, parts);
+    return status;
+}
+
+int quaternion_sum(const quaternion_t* q, size_t count, quaternion_t* result) {
+    if (!result || (!q && count > 0)) return HC_ERROR_NULL_PTR;
+    return reduce_dispatch(q, count, 0, result);
+}
+
+int quaternion_product(const quaternion_t* q, size_t count, quaternion_t* result) {
+    if (!result || (!q && count > 0)) return HC_ERROR_NULL_PTR;
+    return reduce_dispatch(q, count, 1, result);
+}
+
+/*
+ * Unit quaternions
+ */
+
+// Unit inputs are trusted; debug builds catch one that skipped unit_quaternion_make or drifted
+#define UNIT_CHECK(u) assert(fabsf((u)->q.w * (u)->q.w + (u)->q.x * (u)->q.x + (u)->q.y * (u)->q.y + \
+                                   (u)->q.z * (u)->q.z - 1.0f) <= HC_UNIT_TOLERANCE && "not a unit quaternion")
+
+// Past this dot product the two ends are so close that the sine weights lose
+// precision; lerp and renormalize instead
+#define SLERP_LINEAR_DOT 0.9995f
+
+// v + w t + u x t with t = 2 (u x v): 15 multiplies, against 32 for q v q*
+static void unit_rotate(const quaternion_t* q, const float v[3], float result[3]) {
+    float tx = 2.0f * (q->y * v[2] - q->z * v[1]);
+    float ty = 2.0f * (q->z * v[0] - q->x * v[2]);
+    float tz = 2.0f * (q->x * v[1] - q->y * v[0]);
+    
+    float rx = v[0] + q->w * tx + (q->y * tz - q->z * ty);
+    float ry = v[1] + q->w * ty + (q->z * tx - q->x * tz);
+    float rz = v[2] + q->w * tz + (q->x * ty - q->y * tx);
+    
+    result[0] = rx;
+    result[1] = ry;
+    result[2] = rz;
+}
+
+static void unit_slerp(const quaternion_t* a, const quaternion_t* b, float t, quaternion_t* result) {
+    float d = a->w * b->w + a->x * b->x + a->y * b->y + a->z * b->z;
+    float sign = 1.0f;
+    
+    // q and -q are the same rotation; take the short way round
+    if (d < 0.0f) {
+        d = -d;
+        sign = -1.0f;
+    }
+    
+    float wa, wb;
+    if (d > SLERP_LINEAR_DOT) {
+        wa = 1.0f - t;
+        wb = t;
+    } else {
+        float theta = acosf(d);
+        float inv_sin = 1.0f / sinf(theta);
+        wa = sinf((1.0f - t) * theta) * inv_sin;
+        wb = sinf(t * theta) * inv_sin;
+    }
+    wb *= sign;
+    
+    quaternion_t r = { wa * a->w + wb * b->w, wa * a->x + wb * b->x,
+                       wa * a->y + wb * b->y, wa * a->z + wb * b->z };
+    if (d > SLERP_LINEAR_DOT) scalar_normalize(&r, &r);
+    *result = r;
+}
+
+// Finite components past about 1e19 overflow the squared norm; dividing by the
+// largest component first keeps the direction and brings the norm into [1, 2]
+static float unit_largest(const quaternion_t* q) {
+    return fmaxf(fmaxf(fabsf(q->w), fabsf(q->x)), fmaxf(fabsf(q->y), fabsf(q->z)));
+}
+
+static void unit_scale_down(const quaternion_t* q, float s, quaternion_t* scaled) {
+    quaternion_t r = { q->w / s, q->x / s, q->y / s, q->z / s };
+    *scaled = r;
+}
+
+// Validates and normalizes an arbitrary input for the unit paths
+static int unit_from(const quaternion_t* q, quaternion_t* unit) {
+    if (!quaternion_is_valid(q)) return HC_ERROR_INVALID_DATA;
+    
+    float n2 = q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z;
+    if (isfinite(n2)) return scalar_normalize(q, unit);
+    
+    quaternion_t scaled;
+    unit_scale_down(q, unit_largest(q), &scaled);
+    return scalar_normalize(&scaled, unit);
+}
+
+int quaternion_inverse(const quaternion_t* q, quaternion_t* result) {
+    if (!q || !result) return HC_ERROR_NULL_PTR;
+    if (!quaternion_is_valid(q)) return HC_ERROR_INVALID_DATA;
+    
+    float n2 = q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z;
+    if (n2 < norm_epsilon * norm_epsilon) return HC_ERROR_DIVIDE_ZERO;
+    
+    // q^-1 = conj(q / s) / (|q / s|^2 s) when |q|^2 overflows
+    if (!isfinite(n2)) {
+        float s = unit_largest(q);
+        quaternion_t scaled;
+        unit_scale_down(q, s, &scaled);
+        float d = (scaled.w * scaled.w + scaled.x * scaled.x + scaled.y * scaled.y + scaled.z * scaled.z) * s;
+        quaternion_t r = { scaled.w / d, -scaled.x / d, -scaled.y / d, -scaled.z / d };
+        *result = r;
+        return HC_SUCCESS;
+    }
+    
+    quaternion_t r = { q->w / n2, -q->x / n2, -q->y / n2, -q->z / n2 };
+    *result = r;
+    return HC_SUCCESS;
+}
+
+int quaternion_rotate(const quaternion_t* q, const float v[3], float result[3]) {
+    if (!q || !v || !result) return HC_ERROR_NULL_PTR;
+    
+    quaternion_t u;
+    int status = unit_from(q, &u);
+    if (status != HC_SUCCESS) return status;
+    
+    unit_rotate(&u, v, result);
+    return HC_SUCCESS;
+}
+
+int quaternion_slerp(const quaternion_t* a, const quaternion_t* b, float t, quaternion_t* result) {
+    if (!a || !b || !result) return HC_ERROR_NULL_PTR;
+    
+    quaternion_t ua, ub;
+    int status = unit_from(a, &ua);
+    if (status == HC_SUCCESS) status = unit_from(b, &ub);
+    if (status != HC_SUCCESS) return status;
+    
+    unit_slerp(&ua, &ub, t, result);
+    return HC_SUCCESS;
+}
+
+int unit_quaternion_make(const quaternion_t* q, unit_quaternion_t* result) {
+    if (!q || !result) return HC_ERROR_NULL_PTR;
+    return unit_from(q, &result->q);
+}
+
+// Keys come out normalized: no component of the raw key is closer to zero than 1/65535
+void unit_quaternion_generate_key(unit_quaternion_t* key, uint64_t seed) {
+    quaternion_generate_key(key ? &key->q : NULL, seed);
+}
+
+int unit_quaternion_multiply(const unit_quaternion_t* a, const unit_quaternion_t* b, unit_quaternion_t* result) {
+    if (!a || !b || !result) return HC_ERROR_NULL_PTR;
+    UNIT_CHECK(a);
+    UNIT_CHECK(b);
+    
+    scalar_multiply(&a->q, &b->q, &result->q);
+    return HC_SUCCESS;
+}
+
+int unit_quaternion_inverse(const unit_quaternion_t* q, unit_quaternion_t* result) {
+    if (!q || !result) return HC_ERROR_NULL_PTR;
+    UNIT_CHECK(q);
+    
+    scalar_conjugate(&q->q, &result->q);
+    return HC_SUCCESS;
+}
+
+int unit_quaternion_rotate(const unit_quaternion_t* q, const float v[3], float result[3]) {
+    if (!q || !v || !result) return HC_ERROR_NULL_PTR;
+    UNIT_CHECK(q);
+    
+    unit_rotate(&q->q, v, result);
+    return HC_SUCCESS;
+}
+
+int unit_quaternion_slerp(const unit_quaternion_t* a, const unit_quaternion_t* b, float t,
+                          unit_quaternion_t* result) {
+    if (!a || !b || !result) return HC_ERROR_NULL_PTR;
+    UNIT_CHECK(a);
+    UNIT_CHECK(b);
+    
+    unit_slerp(&a->q, &b->q, t, &result->q);
+    return HC_SUCCESS;
+}
+
+// One Newton step towards norm 1, q * (3 - |q|^2) / 2: no square root or division
+void unit_quaternion_renormalize(unit_quaternion_t* q) {
+    if (!q) return;
+    
+    float n2 = q->q.w * q->q.w + q->q.x * q->q.x + q->q.y * q->q.y + q->q.z * q->q.z;
+    float s = 0.5f * (3.0f - n2);
+    q->q.w *= s; q->q.x *= s; q->q.y *= s; q->q.z *= s;
+}
+
+_Static_assert(sizeof(quaternion_a16_t) == sizeof(quaternion_t) && _Alignof(quaternion_a16_t) == 16,
+               "quaternion_a16_t must keep the quaternion_t layout");
+
+quaternion_a16_t* hc_quaternion_array_alloc(size_t count) {
+    if (count == 0 || count > SIZE_MAX / sizeof(quaternion_a16_t)) return NULL;
+    return hc_aligned_alloc(count * sizeof(quaternion_a16_t), HC_ARRAY_ALIGNMENT);
+}
+
+void hc_quaternion_array_free(quaternion_a16_t* array) {
+    hc_aligned_free(array);
+}
+
+// Aligned calls report under the same stats entries as their unaligned counterparts
+int quaternion_multiply_batch_aligned(const quaternion_a16_t* q1, const quaternion_a16_t* q2,
+                                      quaternion_a16_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_MULTIPLY, count);
+    int status = (!q1 || !q2 || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch_aligned(HC_KERNEL_MULTIPLY, q1, q2, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_MULTIPLY, count, status);
+    stats_end(HC_API_MULTIPLY_BATCH, 2 * count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_add_batch_aligned(const quaternion_a16_t* q1, const quaternion_a16_t* q2,
+                                 quaternion_a16_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_ADD, count);
+    int status = (!q1 || !q2 || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch_aligned(HC_KERNEL_ADD, q1, q2, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_ADD, count, status);
+    stats_end(HC_API_ADD_BATCH, 2 * count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_conjugate_batch_aligned(const quaternion_a16_t* input, quaternion_a16_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_CONJUGATE, count);
+    int status = (!input || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch_aligned(HC_KERNEL_CONJUGATE, input, NULL, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_CONJUGATE, count, status);
+    stats_end(HC_API_CONJUGATE_BATCH, count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+int quaternion_normalize_batch_aligned(const quaternion_a16_t* input, quaternion_a16_t* result, size_t count) {
+    uint64_t start = stats_begin();
+    HC_PROBE2(batch_entry, HC_KERNEL_NORMALIZE, count);
+    int status = (!input || !result) ? HC_ERROR_NULL_PTR
+               : batch_dispatch_aligned(HC_KERNEL_NORMALIZE, input, NULL, result, count);
+    HC_PROBE3(batch_return, HC_KERNEL_NORMALIZE, count, status);
+    stats_end(HC_API_NORMALIZE_BATCH, count * sizeof(quaternion_t), status, start);
+    return status;
+}
+
+/*
+ * Aligned and huge-page allocation
+ */
+
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+#define ALLOC_MAGIC 0x48434131u
+
+// Sits just below every pointer hc_aligned_alloc returns
+typedef struct {
+    void* base;                      // Start of the malloc block or mapping
+    size_t mapped;                   // Mapping length; 0 for malloc blocks
+    uint32_t backing;                // hc_huge_pages_t
+    uint32_t magic;
+} alloc_header_t;
+
+static _Atomic int huge_pages_mode = HC_HUGE_PAGES_OFF;
+
+int hc_huge_pages_set(hc_huge_pages_t mode) {
+    if ((unsigned)mode > HC_HUGE_PAGES_HUGETLB) return HC_ERROR_INVALID_DATA;
+#if !defined(MADV_HUGEPAGE) && !defined(MAP_HUGETLB)
+    if (mode != HC_HUGE_PAGES_OFF) return HC_ERROR_UNSUPPORTED;
+#endif
+    
+    atomic_store(&huge_pages_mode, (int)mode);
+    return HC_SUCCESS;
+}
+
+hc_huge_pages_t hc_huge_pages_get(void) {
+    return (hc_huge_pages_t)atomic_load(&huge_pages_mode);
+}
+
+const char* hc_huge_pages_name(hc_huge_pages_t mode) {
+    static const char* const names[] = { "off", "thp", "hugetlb" };
+    
+    if ((unsigned)mode > HC_HUGE_PAGES_HUGETLB) return "unknown";
+    return names[mode];
+}
+
+#if defined(MADV_HUGEPAGE) || defined(MAP_HUGETLB)
+// Anonymous mapping of a multiple of 2 MiB, itself 2 MiB aligned
+static void* alloc_mapped(size_t length, hc_huge_pages_t mode) {
+    if (mode == HC_HUGE_PAGES_HUGETLB) {
+#ifdef MAP_HUGETLB
+        void* p = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        return p == MAP_FAILED ? NULL : p;
+#else
+        return NULL;
+#endif
+    }
+    
+    // Over-map by one huge page and trim both ends to reach the alignment
+    size_t span = length + HUGE_PAGE_SIZE;
+    char* p = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return NULL;
+    
+    char* aligned = (char*)(((uintptr_t)p + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+    if (aligned > p) munmap(p, (size_t)(aligned - p));
+    if (p + span > aligned + length) munmap(aligned + length, (size_t)(p + span - (aligned + length)));
+    
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+#endif
+
+static void* alloc_finish(void* base, size_t prefix, size_t mapped, hc_huge_pages_t backing) {
+    alloc_header_t* header = (alloc_header_t*)((char*)base + prefix) - 1;
+    
+    header->base = base;
+    header->mapped = mapped;
+    header->backing = (uint32_t)backing;
+    header->magic = ALLOC_MAGIC;
+    return (char*)base + prefix;
+}
+
+void* hc_aligned_alloc(size_t size, size_t alignment) {
+    void* ptr = NULL;
+    
+    if (size == 0) return NULL;
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    
+    // The header goes in front, in a prefix that keeps the caller's bytes aligned
+    size_t prefix = alignment;
+    while (prefix < sizeof(alloc_header_t)) prefix *= 2;
+    if (size > SIZE_MAX - prefix - HUGE_PAGE_SIZE) return NULL;
+    
+#if defined(MADV_HUGEPAGE) || defined(MAP_HUGETLB)
+    hc_huge_pages_t mode = hc_huge_pages_get();
+    if (mode != HC_HUGE_PAGES_OFF && size >= HC_HUGE_PAGE_MIN && alignment <= HUGE_PAGE_SIZE) {
+        size_t mapped = (prefix + size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        hc_huge_pages_t backing = mode;
+        void* base = alloc_mapped(mapped, mode);
+        
+        if (!base && mode == HC_HUGE_PAGES_HUGETLB) {
+            backing = HC_HUGE_PAGES_THP;
+            base = alloc_mapped(mapped, backing);
+        }
+        if (base) return alloc_finish(base, prefix, mapped, backing);
+    }
+#endif
+    
+    if (posix_memalign(&ptr, alignment, prefix + size) != 0) return NULL;
+    return alloc_finish(ptr, prefix, 0, HC_HUGE_PAGES_OFF);
+}
+
+void hc_aligned_free(void* ptr) {
+    if (!ptr) return;
+    
+    alloc_header_t* header = (alloc_header_t*)ptr - 1;
+    header->magic = 0;
+    if (header->mapped) {
+        munmap(header->base, header->mapped);
+    } else {
+        free(header->base);
+    }
+}
+
+hc_huge_pages_t hc_aligned_backing(const void* ptr) {
+    if (!ptr) return HC_HUGE_PAGES_OFF;
+    
+    const alloc_header_t* header = (const alloc_header_t*)ptr - 1;
+    return header->magic == ALLOC_MAGIC ? (hc_huge_pages_t)header->backing : HC_HUGE_PAGES_OFF;
+}
+
+/*
+ * Buffer pool
+ */
+
+#define BUFFER_MIN_SHIFT 6
+#define BUFFER_CLASSES 15                    // 64 B .. 1 MiB
+#define BUFFER_UNPOOLED BUFFER_CLASSES
+#define BUFFER_HEADER HC_CACHE_LINE          // Keeps the caller's bytes 64-byte aligned
+#define BUFFER_MAGIC 0x48434246u              // Handed out
+#define BUFFER_FREE_MAGIC 0x66726565u         // Sitting in a cache or the shared pool
+
+typedef struct buffer_block {
+    struct buffer_block* next;
+    size_t capacity;
+    uint32_t magic;
+    uint32_t size_class;
+} buffer_block_t;
+
+typedef struct {
+    buffer_block_t* head;
+    size_t count;
+} buffer_list_t;
+
+static buffer_list_t buffer_shared[BUFFER_CLASSES];
+static pthread_mutex_t buffer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t buffer_once = PTHREAD_ONCE_INIT;
+static pthread_key_t buffer_key;
+static _Thread_local buffer_list_t buffer_cache[BUFFER_CLASSES];
+static _Thread_local int buffer_registered;
+
+// Per-thread cache depth: 64 small buffers, down to 2 of the largest
+static size_t buffer_cache_limit(int size_class) {
+    size_t limit = (HC_BUFFER_MAX_POOLED >> (BUFFER_MIN_SHIFT + size_class)) * 2;
+    if (limit > 64) limit = 64;
+    return limit < 2 ? 2 : limit;
+}
+
+static void* buffer_data(buffer_block_t* block) {
+    return (char*)block + BUFFER_HEADER;
+}
+
+static buffer_block_t* buffer_block(const void* buffer) {
+    return (buffer_block_t*)((char*)buffer - BUFFER_HEADER);
+}
+
+// Moves up to count blocks from the front of one list to another
+static void buffer_move(buffer_list_t* from, buffer_list_t* to, size_t count) {
+    while (count-- > 0 && from->head) {
+        buffer_block_t* block = from->head;
+        from->head = block->next;
+        from->count--;
+        block->next = to->head;
+        to->head = block;
+        to->count++;
+    }
+}
+
+static void buffer_thread_exit(void* arg) {
+    buffer_list_t* cache = (buffer_list_t*)arg;
+    
+    pthread_mutex_lock(&buffer_lock);
+    for (int c = 0; c < BUFFER_CLASSES; c++) {
+        buffer_move(&cache[c], &buffer_shared[c], cache[c].count);
+    }
+    pthread_mutex_unlock(&buffer_lock);
+}
+
+static void buffer_init_key(void) {
+    pthread_key_create(&buffer_key, buffer_thread_exit);
+}
+
+// Hands the cache to the shared pool when the thread exits
+static void buffer_register(void) {
+    pthread_once(&buffer_once, buffer_init_key);
+    pthread_setspecific(buffer_key, buffer_cache);
+    buffer_registered = 1;
+}
+
+static int buffer_class(size_t size) {
+    int size_class = 0;
+    while (((size_t)1 << (BUFFER_MIN_SHIFT + size_class)) < size) size_class++;
+    return size_class;
+}
+
+static void* buffer_new(size_t capacity, int size_class) {
+    buffer_block_t* block = hc_aligned_alloc(BUFFER_HEADER + capacity, HC_CACHE_LINE);
+    if (!block) return NULL;
+    
+    block->next = NULL;
+    block->capacity = capacity;
+    block->magic = BUFFER_MAGIC;
+    block->size_class = (uint32_t)size_class;
+    return buffer_data(block);
+}
+
+void* hc_buffer_acquire(size_t size) {
+    if (size == 0) return NULL;
+    if (size > HC_BUFFER_MAX_POOLED) return buffer_new(size, BUFFER_UNPOOLED);
+    
+    int size_class = buffer_class(size);
+    buffer_list_t* cache = &buffer_cache[size_class];
+    
+    if (!buffer_registered) buffer_register();
+    
+    // Refill half a cache's worth in one trip to the shared pool
+    if (!cache->head) {
+        pthread_mutex_lock(&buffer_lock);
+        buffer_move(&buffer_shared[size_class], cache, buffer_cache_limit(size_class) / 2);
+        pthread_mutex_unlock(&buffer_lock);
+    }
+    
+    buffer_block_t* block = cache->head;
+    if (!block) return buffer_new((size_t)1 << (BUFFER_MIN_SHIFT + size_class), size_class);
+    
+    // Anything else here means a block was written after its release
+    assert(block->magic == BUFFER_FREE_MAGIC && "pooled buffer written after release");
+    cache->head = block->next;
+    cache->count--;
+    block->next = NULL;
+    block->magic = BUFFER_MAGIC;
+    return buffer_data(block);
+}
+
+void hc_buffer_release(void* buffer) {
+    if (!buffer) return;
+    
+    // A second release finds the free magic; pushing the block again would loop the free list
+    buffer_block_t* block = buffer_block(buffer);
+    assert(block->magic != BUFFER_FREE_MAGIC && "buffer released twice");
+    assert(block->magic == BUFFER_MAGIC && "not a buffer from hc_buffer_acquire");
+    if (block->magic != BUFFER_MAGIC) return;
+    
+    if (block->size_class == BUFFER_UNPOOLED) {
+        block->magic = 0;
+        hc_aligned_free(block);
+        return;
+    }
+    if (!buffer_registered) buffer_register();
+    
+    buffer_list_t* cache = &buffer_cache[block->size_class];
+    block->magic = BUFFER_FREE_MAGIC;
+    block->next = cache->head;
+    cache->head = block;
+    cache->count++;
+    
+    // Overflow goes back to the shared pool, half a cache at a time
+    size_t limit = buffer_cache_limit((int)block->size_class);
+    if (cache->count > limit) {
+        pthread_mutex_lock(&buffer_lock);
+        buffer_move(cache, &buffer_shared[block->size_class], limit / 2);
+        pthread_mutex_unlock(&buffer_lock);
+    }
+}
+
+size_t hc_buffer_capacity(const void* buffer) {
+    if (!buffer) return 0;
+    
+    const buffer_block_t* block = buffer_block(buffer);
+    return block->magic == BUFFER_MAGIC ? block->capacity : 0;
+}
+
+void hc_buffer_trim(void) {
+    buffer_list_t released[BUFFER_CLASSES];
+    
+    pthread_mutex_lock(&buffer_lock);
+    memcpy(released, buffer_shared, sizeof(released));
+    memset(buffer_shared, 0, sizeof(buffer_shared));
+    pthread_mutex_unlock(&buffer_lock);
+    
+    for (int c = 0; c < BUFFER_CLASSES; c++) {
+        while (released[c].head) {
+            buffer_block_t* block = released[c].head;
+            released[c].head = block->next;
+            block->magic = 0;
+            hc_aligned_free(block);
+        }
+    }
+}
+
+size_t hypercomplex_cipher_length(size_t length) {
+    size_t blocks = (length + CIPHER_BLOCK_BYTES - 1) / CIPHER_BLOCK_BYTES;
+    return sizeof(hypercomplex_header_t) + blocks * sizeof(quaternion_t);
+}
+
+int hypercomplex_encrypt_data_pooled(const void* plaintext, size_t length,
+                                     const quaternion_t* key, void** ciphertext,
+                                     size_t* cipher_length) {
+    if (!ciphertext || !cipher_length) return HC_ERROR_NULL_PTR;
+    
+    *ciphertext = NULL;
+    size_t capacity = hypercomplex_cipher_length(length);
+    void* buffer = hc_buffer_acquire(capacity);
+    if (!buffer) return HC_ERROR_NO_MEMORY;
+    
+    int result = hypercomplex_encrypt_data(plaintext, length, key, buffer, &capacity);
+    if (result != HC_SUCCESS) {
+        hc_buffer_release(buffer);
+        return result;
+    }
+    
+    *ciphertext = buffer;
+    *cipher_length = capacity;
+    return HC_SUCCESS;
+}
+
+/*
+ * Prometheus exporter
+ */
+
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t length;                   // Full length, even past capacity
+} prom_out_t;
+
+static void prom_printf(prom_out_t* out, const char* format, ...) {
+    size_t room = out->length < out->capacity ? out->capacity - out->length : 0;
+    va_list args;
+    
+    va_start(args, format);
+    int written = vsnprintf(room ? out->buffer + out->length : NULL, room, format, args);
+    va_end(args);
+    
+    if (written > 0) out->length += (size_t)written;
+}
+
+static const char* const prom_error_names[HC_STATS_ERROR_SLOTS] = {
+    "unknown", "null_ptr", "divide_zero", "invalid_data", "no_memory", "unsupported"
+};
+
+// Fixed exposition buckets; each internal bucket counts toward the first bound at or above its top
+static const uint64_t prom_bounds_ns[] = {
+    1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+#define PROM_BOUNDS (sizeof(prom_bounds_ns) / sizeof(prom_bounds_ns[0]))
+
+static void prom_counters(prom_out_t* out, const hc_stats_t* stats) {
+    prom_printf(out, "# HELP hypercomplex_calls_total Calls per API.\n"
+                     "# TYPE hypercomplex_calls_total counter\n");
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        prom_printf(out, "hypercomplex_calls_total{api=\"%s\"} %llu\n",
+                    hc_api_name((hc_api_t)api), (unsigned long long)stats->apis[api].calls);
+    }
+    
+    prom_printf(out, "# HELP hypercomplex_bytes_total Payload bytes per API.\n"
+                     "# TYPE hypercomplex_bytes_total counter\n");
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        prom_printf(out, "hypercomplex_bytes_total{api=\"%s\"} %llu\n",
+                    hc_api_name((hc_api_t)api), (unsigned long long)stats->apis[api].bytes);
+    }
+    
+    prom_printf(out, "# HELP hypercomplex_call_seconds_total Time spent in each API.\n"
+                     "# TYPE hypercomplex_call_seconds_total counter\n");
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        prom_printf(out, "hypercomplex_call_seconds_total{api=\"%s\"} %.9f\n",
+                    hc_api_name((hc_api_t)api), stats->apis[api].total_ns / 1e9);
+    }
+    
+    prom_printf(out, "# HELP hypercomplex_errors_total Failed calls per API and error code.\n"
+                     "# TYPE hypercomplex_errors_total counter\n");
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        for (int code = 0; code < HC_STATS_ERROR_SLOTS; code++) {
+            prom_printf(out, "hypercomplex_errors_total{api=\"%s\",code=\"%s\"} %llu\n",
+                        hc_api_name((hc_api_t)api), prom_error_names[code],
+                        (unsigned long long)stats->apis[api].errors[code]);
+        }
+    }
+}
+
+static void prom_histogram(prom_out_t* out, hc_api_t api, hc_size_class_t size_class,
+                           const hc_histogram_t* hist) {
+    uint64_t cumulative = 0;
+    double sum_ns = 0.0;
+    int i = 0;
+    
+    for (size_t b = 0; b < PROM_BOUNDS; b++) {
+        for (; i < HC_HIST_BUCKETS && hist_bucket_upper(i) <= prom_bounds_ns[b]; i++) {
+            cumulative += hist->buckets[i];
+            sum_ns += (double)hist->buckets[i] * hist_bucket_upper(i);
+        }
+        prom_printf(out, "hypercomplex_latency_seconds_bucket{api=\"%s\",size=\"%s\",le=\"%g\"} %llu\n",
+                    hc_api_name(api), hc_size_class_name(size_class),
+                    prom_bounds_ns[b] / 1e9, (unsigned long long)cumulative);
+    }
+    for (; i < HC_HIST_BUCKETS; i++) {
+        sum_ns += (double)hist->buckets[i] * hist_bucket_upper(i);
+    }
+    
+    prom_printf(out, "hypercomplex_latency_seconds_bucket{api=\"%s\",size=\"%s\",le=\"+Inf\"} %llu\n",
+                hc_api_name(api), hc_size_class_name(size_class), (unsigned long long)hist->count);
+    prom_printf(out, "hypercomplex_latency_seconds_sum{api=\"%s\",size=\"%s\"} %.9f\n",
+                hc_api_name(api), hc_size_class_name(size_class), sum_ns / 1e9);
+    prom_printf(out, "hypercomplex_latency_seconds_count{api=\"%s\",size=\"%s\"} %llu\n",
+                hc_api_name(api), hc_size_class_name(size_class), (unsigned long long)hist->count);
+}
+
+size_t hc_stats_format_prometheus(char* buffer, size_t capacity) {
+    prom_out_t out = { buffer, buffer ? capacity : 0, 0 };
+    hc_tuning_t tuned;
+    hc_stats_t stats;
+    hc_histogram_t hist;
+    
+    tuning_snapshot(&tuned);
+    prom_printf(&out, "# HELP hypercomplex_stats_enabled Active HC_STATS_* flags.\n"
+                      "# TYPE hypercomplex_stats_enabled gauge\n"
+                      "hypercomplex_stats_enabled %u\n", hc_stats_enabled());
+    prom_printf(&out, "# HELP hypercomplex_backend_info Backend behind the batch kernels.\n"
+                      "# TYPE hypercomplex_backend_info gauge\n"
+                      "hypercomplex_backend_info{backend=\"%s\"} 1\n",
+                hc_backend_name(tuned.batch_backend));
+    prom_printf(&out, "# HELP hypercomplex_threads Threads per large call.\n"
+                      "# TYPE hypercomplex_threads gauge\n"
+                      "hypercomplex_threads %u\n", tuned.threads);
+    
+    if (hc_stats_snapshot(&stats) == HC_SUCCESS) {
+        prom_counters(&out, &stats);
+    }
+    
+    // Only size classes that have seen calls; the sum is estimated from bucket tops
+    int header = 0;
+    for (int api = 0; api < HC_API_COUNT; api++) {
+        for (int c = 0; c < HC_SIZE_CLASS_COUNT; c++) {
+            if (hc_histogram_snapshot((hc_api_t)api, (hc_size_class_t)c, &hist) != HC_SUCCESS) continue;
+            if (hist.count == 0) continue;
+            
+            if (!header) {
+                prom_printf(&out, "# HELP hypercomplex_latency_seconds Call latency by API and payload size.\n"
+                                  "# TYPE hypercomplex_latency_seconds histogram\n");
+                header = 1;
+            }
+            prom_histogram(&out, (hc_api_t)api, (hc_size_class_t)c, &hist);
+        }
+    }
+    
+    return out.length;
+}
+
+static struct {
+    pthread_mutex_t lock;            // Serializes start and stop
+    pthread_t thread;
+    int fd;
+    _Atomic int stop;
+    char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+} exporter = { .lock = PTHREAD_MUTEX_INITIALIZER, .fd = -1 };
+
+static void exporter_send(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent <= 0) return;
+        data += sent;
+        length -= (size_t)sent;
+    }
+}
+
+// Every request gets the metrics; the request itself is read only so closing doesn't reset it
+static void exporter_serve(int client) {
+    struct timeval timeout = { 1, 0 };
+    char request[1024];
+    char header[128];
+    
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (recv(client, request, sizeof(request), 0) < 0) return;
+    
+    // Counters and new size classes can grow between the sizing pass and the
+    // real one, so resize until the text fits and never send past the buffer
+    size_t capacity = 0;
+    size_t length = hc_stats_format_prometheus(NULL, 0);
+    char* body = NULL;
+    while (length >= capacity) {
+        capacity = length + 256;
+        char* grown = realloc(body, capacity);
+        if (!grown) {
+            free(body);
+            return;
+        }
+        body = grown;
+        length = hc_stats_format_prometheus(body, capacity);
+    }
+    
+    int header_length = snprintf(header, sizeof(header),
+                                 "HTTP/1.0 200 OK\r\n"
+                                 "Content-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: %zu\r\n\r\n", length);
+    exporter_send(client, header, (size_t)header_length);
+    exporter_send(client, body, length);
+    free(body);
+}
+
+static void* exporter_main(void* arg) {
+    (void)arg;
+    
+    // Wake up periodically to notice hc_exporter_stop
+    while (!atomic_load(&exporter.stop)) {
+        struct pollfd listener = { .fd = exporter.fd, .events = POLLIN };
+        if (poll(&listener, 1, 100) <= 0) continue;
+        
+        int client = accept(exporter.fd, NULL, NULL);
+        if (client < 0) continue;
+        
+        exporter_serve(client);
+        close(client);
+    }
+    
+    return NULL;
+}
+
+// Binds and listens under the lock, so a second start can't unlink a live exporter's socket
+static int exporter_bind(const struct sockaddr* address, socklen_t size, const char* path) {
+    int reuse = 1;
+    int fd = socket(address->sa_family, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    
+    if (path) {
+        unlink(path);                // A stale socket from an earlier run
+    } else {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    
+    if (bind(fd, address, size) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+static int exporter_start(const struct sockaddr* address, socklen_t size, const char* path) {
+    pthread_mutex_lock(&exporter.lock);
+    
+    int result = HC_SUCCESS;
+    int fd = exporter.fd >= 0 ? -1 : exporter_bind(address, size, path);
+    
+    if (fd < 0) {
+        result = HC_ERROR_INVALID_DATA;
+    } else {
+        exporter.fd = fd;
+        atomic_store(&exporter.stop, 0);
+        snprintf(exporter.path, sizeof(exporter.path), "%s", path ? path : "");
+        if (pthread_create(&exporter.thread, NULL, exporter_main, NULL) != 0) {
+            close(fd);
+            if (path) unlink(path);
+            exporter.fd = -1;
+            result = HC_ERROR_NO_MEMORY;
+        }
+    }
+    
+    pthread_mutex_unlock(&exporter.lock);
+    return result;
+}
+
+int hc_exporter_start_unix(const char* path) {
+    struct sockaddr_un address;
+    
+    if (!path) return HC_ERROR_NULL_PTR;
+    if (strlen(path) >= sizeof(address.sun_path)) return HC_ERROR_INVALID_DATA;
+    
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path, strlen(path) + 1);
+    
+    return exporter_start((struct sockaddr*)&address, sizeof(address), path);
+}
+
+int hc_exporter_start_tcp(uint16_t port) {
+    struct sockaddr_in address;
+    
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    return exporter_start((struct sockaddr*)&address, sizeof(address), NULL);
+}
+
+void hc_exporter_stop(void) {
+    pthread_mutex_lock(&exporter.lock);
+    
+    if (exporter.fd >= 0) {
+        atomic_store(&exporter.stop, 1);
+        pthread_join(exporter.thread, NULL);
+        close(exporter.fd);
+        if (exporter.path[0]) unlink(exporter.path);
+        exporter.fd = -1;
+        exporter.path[0] = '\0';
+    }
+    
+    pthread_mutex_unlock(&exporter.lock);
+}
+
+/*
+ * Hardware performance counters
+ */
+
+#ifdef __linux__
+// Every counter reads in group format; one opened without a group leads a group of one.
+// inherit would cover threads started later, but not the pool's existing workers,
+// and older kernels refuse it together with group reads
+static int perf_open_counter(uint32_t type, uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd < 0;            // Members start and stop with their leader
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// A group the PMU cannot hold is accepted but never scheduled: it reads zero time running
+static int perf_group_runs(int leader) {
+    uint64_t data[3 + HC_COUNTER_COUNT];     // nr, time enabled, time running, values
+    
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    for (volatile int spin = 0; spin < 100000; spin++) {
+    }
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    
+    return read(leader, data, sizeof(data)) >= (ssize_t)(3 * sizeof(uint64_t)) && data[2] > 0;
+}
+
+// fds that lead a group, including counters on their own, are the ones to start, stop and read
+static int perf_is_leader(const hc_perf_session_t* session, int counter) {
+    return session->fds[counter] >= 0 && (counter == session->leader || !(session->grouped & (1u << counter)));
+}
+#endif
+
+int hc_perf_open(hc_perf_session_t* session) {
+    if (!session) return HC_ERROR_NULL_PTR;
+    
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+        session->fds[i] = -1;
+    }
+    session->leader = -1;
+    session->grouped = 0;
+    
+#ifdef __linux__
+    struct { uint32_t type; uint64_t config; } events[HC_COUNTER_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_RAW, 0 },
+    };
+    int count = HC_COUNTER_FP_ASSISTS;
+    
+    // FP assist events are model specific (e.g. 0x1eca is FP_ASSIST.ANY on Skylake)
+    const char* fp_assist = getenv("HC_PERF_FP_ASSIST_EVENT");
+    if (fp_assist && *fp_assist) {
+        events[HC_COUNTER_FP_ASSISTS].config = strtoull(fp_assist, NULL, 0);
+        count = HC_COUNTER_COUNT;
+    }
+    
+    // The first counter that opens leads; the rest join its group
+    for (int i = 0; i < count; i++) {
+        int group_fd = session->leader >= 0 ? session->fds[session->leader] : -1;
+        session->fds[i] = perf_open_counter(events[i].type, events[i].config, group_fd);
+        if (session->fds[i] < 0) continue;
+        
+        if (session->leader < 0) session->leader = i;
+        session->grouped |= 1u << i;
+    }
+    
+    // Shed the last members until the group fits; they count on their own instead
+    while (session->leader >= 0 && (session->grouped & (session->grouped - 1)) &&
+           !perf_group_runs(session->fds[session->leader])) {
+        int last = 31 - __builtin_clz(session->grouped);
+        close(session->fds[last]);
+        session->grouped &= ~(1u << last);
+        session->fds[last] = perf_open_counter(events[last].type, events[last].config, -1);
+    }
+    
+    int opened = 0;
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+        if (session->fds[i] >= 0) opened++;
+    }
+    return opened ? HC_SUCCESS : HC_ERROR_UNSUPPORTED;
+#else
+    return HC_ERROR_UNSUPPORTED;
+#endif
+}
+
+int hc_perf_start(hc_perf_session_t* session) {
+    if (!session) return HC_ERROR_NULL_PTR;
+    
+#ifdef __linux__
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+        if (!perf_is_leader(session, i)) continue;
+        ioctl(session->fds[i], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(session->fds[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    
+    return HC_SUCCESS;
+}
+
+int hc_perf_stop(hc_perf_session_t* session, hc_hw_counters_t* counters) {
+    if (!session || !counters) return HC_ERROR_NULL_PTR;
+    
+    memset(counters, 0, sizeof(*counters));
+    
+#ifdef __linux__
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+        if (perf_is_leader(session, i)) ioctl(session->fds[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+        uint64_t data[3 + HC_COUNTER_COUNT];     // nr, time enabled, time running, values
+        if (!perf_is_leader(session, i)) continue;
+        
+        // A group's values come in the order its members were opened, lowest counter first
+        uint32_t members = (i == session->leader) ? session->grouped : 1u << i;
+        uint64_t nr = (uint64_t)__builtin_popcount(members);
+        if (read(session->fds[i], data, sizeof(data)) != (ssize_t)((3 + nr) * sizeof(uint64_t))) continue;
+        if (data[0] != nr || data[2] == 0) continue;
+        
+        uint64_t* value = &data[3];
+        for (int c = 0; c < HC_COUNTER_COUNT; c++) {
+            if (!(members & (1u << c))) continue;
+            counters->values[c] = data[2] < data[1]
+                ? (uint64_t)((double)*value * (double)data[1] / (double)data[2])
+                : *value;
+            counters->available |= 1u << c;
+            value++;
+        }
+    }
+#endif
+    
+    return counters->available ? HC_SUCCESS : HC_ERROR_UNSUPPORTED;
+}
+
+void hc_perf_close(hc_perf_session_t* session) {
+    if (!session) return;
+    
+    for (int i = 0; i < HC_COUNTER_COUNT; i++) {
+#ifdef __linux__
+        if (session->fds[i] >= 0) close(session->fds[i]);
+#endif
+        session->fds[i] = -1;
+    }
+    session->leader = -1;
+    session->grouped = 0;
+}
+
+const char* hc_counter_name(hc_counter_t counter) {
+    static const char* const names[HC_COUNTER_COUNT] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses", "fp_assists"
+    };
+    
+    if ((unsigned)counter >= HC_COUNTER_COUNT) return "unknown";
+    return names[counter];
+}
+
+/*
+ * Benchmark suite
+ */
+
+#define BENCH_POOL_SIZE 1024                 // Random inputs per pool, small enough to stay in L1
+#define BENCH_POOL_MASK (BENCH_POOL_SIZE - 1)
+#define BENCH_BUFFERS 8                      // Rotating message buffers for the encryption ops
+
+typedef struct {
+    quaternion_t* inputs;
+    quaternion_t* operands;
+    quaternion_t* outputs;
+    uint8_t* plain[BENCH_BUFFERS];
+    uint8_t* cipher[BENCH_BUFFERS];
+    uint8_t* scratch[BENCH_BUFFERS];
+    quaternion_t key;
+    size_t payload;
+    size_t padded;
+    size_t cipher_length;
+    uint64_t seed;
+} bench_ctx_t;
+
+// Results land here so the optimizer must keep the work that produced them
+static volatile float bench_sink;
+
+static inline void bench_escape(const void* p) {
+    __asm__ __volatile__("" : : "r"(p) : "memory");
+}
+
+static uint64_t bench_next_random(uint64_t* state) {
+    // splitmix64
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static float bench_random_float(uint64_t* state) {
+    return (float)(bench_next_random(state) >> 40) / 16777216.0f * 2.0f - 1.0f;
+}
+
+// Random unit quaternions keep long multiply chains clear of overflow and denormals
+static void bench_random_quaternion(quaternion_t* q, uint64_t* state) {
+    do {
+        q->w = bench_random_float(state);
+        q->x = bench_random_float(state);
+        q->y = bench_random_float(state);
+        q->z = bench_random_float(state);
+    } while (quaternion_normalize(q, q) != HC_SUCCESS);
+}
+
+static void bench_teardown(bench_ctx_t* c) {
+    free(c->inputs);
+    for (int b = 0; b < BENCH_BUFFERS; b++) {
+        free(c->plain[b]);
+        free(c->cipher[b]);
+        free(c->scratch[b]);
+    }
+}
+
+static int bench_setup(bench_ctx_t* c, const hc_bench_config_t* config) {
+    memset(c, 0, sizeof(*c));
+    
+    uint64_t state = config->seed;
+    c->seed = config->seed;
+    c->payload = config->payload_bytes;
+    c->padded = ((c->payload + 15) / 16) * 16;
+    c->cipher_length = hypercomplex_cipher_length(c->payload);
+    
+    c->inputs = malloc(3 * BENCH_POOL_SIZE * sizeof(quaternion_t));
+    if (!c->inputs) return HC_ERROR_NO_MEMORY;
+    c->operands = c->inputs + BENCH_POOL_SIZE;
+    c->outputs = c->operands + BENCH_POOL_SIZE;
+    
+    for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+        bench_random_quaternion(&c->inputs[i], &state);
+        bench_random_quaternion(&c->operands[i], &state);
+        c->outputs[i] = c->inputs[i];
+    }
+    quaternion_generate_key(&c->key, bench_next_random(&state));
+    
+    for (int b = 0; b < BENCH_BUFFERS; b++) {
+        c->plain[b] = malloc(c->padded);
+        c->cipher[b] = malloc(c->cipher_length);
+        c->scratch[b] = malloc(c->padded);
+        if (!c->plain[b] || !c->cipher[b] || !c->scratch[b]) {
+            bench_teardown(c);
+            return HC_ERROR_NO_MEMORY;
+        }
+        
+        // Payloads are well-formed floats so denormal assists don't skew the timing
+        float* words = (float*)c->plain[b];
+        for (size_t i = 0; i < c->padded / sizeof(float); i++) {
+            words[i] = bench_random_float(&state);
+        }
+        memcpy(c->scratch[b], c->plain[b], c->padded);
+        
+        size_t length = c->cipher_length;
+        int ret = hypercomplex_encrypt_data(c->plain[b], c->payload, &c->key, c->cipher[b], &length);
+        if (ret != HC_SUCCESS) {
+            bench_teardown(c);
+            return ret;
+        }
+    }
+    
+    return HC_SUCCESS;
+}
+
+// Dependent chain: every call consumes the previous result, exposing latency
+static void bench_chain(bench_ctx_t* c, hc_op_t op, size_t n) {
+    const quaternion_t* in = c->inputs;
+    quaternion_t acc = in[0];
+    size_t idx = 0;
+    
+    switch (op) {
+    case HC_OP_MULTIPLY:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_multiply(&acc, &in[i & BENCH_POOL_MASK], &acc);
+        }
+        break;
+    case HC_OP_ADD:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_add(&acc, &in[i & BENCH_POOL_MASK], &acc);
+        }
+        break;
+    case HC_OP_CONJUGATE:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_conjugate(&acc, &acc);
+        }
+        break;
+    case HC_OP_NORM:
+        for (size_t i = 0; i < n; i++) {
+            acc.w = quaternion_norm(&acc);
+        }
+        break;
+    case HC_OP_NORMALIZE:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_normalize(&acc, &acc);
+        }
+        break;
+    case HC_OP_IS_VALID:
+        for (size_t i = 0; i < n; i++) {
+            idx += (size_t)quaternion_is_valid(&in[idx & BENCH_POOL_MASK]);
+        }
+        break;
+    case HC_OP_GENERATE_KEY: {
+        uint64_t seed = c->seed;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t bits;
+            quaternion_generate_key(&acc, seed);
+            memcpy(&bits, &acc.x, sizeof(bits));
+            seed += bits;
+        }
+        break;
+    }
+    case HC_OP_ENCRYPT:
+        for (size_t i = 0; i < n; i++) {
+            hypercomplex_encrypt(c->scratch[0], &c->key, c->scratch[0], c->padded);
+        }
+        break;
+    case HC_OP_ENCRYPT_DATA:
+        // Each message is the payload of the previous ciphertext
+        for (size_t i = 0; i < n; i++) {
+            size_t length = c->cipher_length;
+            hypercomplex_encrypt_data(c->cipher[(i + 1) & 1] + sizeof(hypercomplex_header_t),
+                                      c->payload, &c->key, c->cipher[i & 1], &length);
+        }
+        break;
+    case HC_OP_DECRYPT_DATA: {
+        // The reported length feeds the next call's input length (it is always zero)
+        size_t dependency = 0;
+        for (size_t i = 0; i < n; i++) {
+            size_t length = c->padded;
+            hypercomplex_decrypt_data(c->cipher[0], c->cipher_length + dependency,
+                                      &c->key, c->scratch[0], &length);
+            dependency = length - c->payload;
+        }
+        break;
+    }
+    case HC_OP_MULTIPLY_BATCH:
+        // Each pass rewrites the array the next pass reads
+        for (size_t i = 0; i < n; i++) {
+            quaternion_multiply_batch(c->outputs, c->operands, c->outputs, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_ADD_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_add_batch(c->outputs, c->operands, c->outputs, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_CONJUGATE_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_conjugate_batch(c->outputs, c->outputs, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_NORMALIZE_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_normalize_batch(c->outputs, c->outputs, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    default:
+        break;
+    }
+    
+    bench_escape(c->outputs);
+    bench_sink = acc.w + (float)idx;
+}
+
+// Independent stream: calls share no data, exposing throughput
+static void bench_stream(bench_ctx_t* c, hc_op_t op, size_t n) {
+    const quaternion_t* in = c->inputs;
+    const quaternion_t* operands = c->operands;
+    quaternion_t* out = c->outputs;
+    size_t valid = 0;
+    
+    switch (op) {
+    case HC_OP_MULTIPLY:
+        for (size_t i = 0; i < n; i++) {
+            size_t j = i & BENCH_POOL_MASK;
+            quaternion_multiply(&in[j], &operands[j], &out[j]);
+        }
+        break;
+    case HC_OP_ADD:
+        for (size_t i = 0; i < n; i++) {
+            size_t j = i & BENCH_POOL_MASK;
+            quaternion_add(&in[j], &operands[j], &out[j]);
+        }
+        break;
+    case HC_OP_CONJUGATE:
+        for (size_t i = 0; i < n; i++) {
+            size_t j = i & BENCH_POOL_MASK;
+            quaternion_conjugate(&in[j], &out[j]);
+        }
+        break;
+    case HC_OP_NORM:
+        for (size_t i = 0; i < n; i++) {
+            size_t j = i & BENCH_POOL_MASK;
+            out[j].w = quaternion_norm(&in[j]);
+        }
+        break;
+    case HC_OP_NORMALIZE:
+        for (size_t i = 0; i < n; i++) {
+            size_t j = i & BENCH_POOL_MASK;
+            quaternion_normalize(&in[j], &out[j]);
+        }
+        break;
+    case HC_OP_IS_VALID:
+        for (size_t i = 0; i < n; i++) {
+            valid += (size_t)quaternion_is_valid(&in[i & BENCH_POOL_MASK]);
+        }
+        break;
+    case HC_OP_GENERATE_KEY:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_generate_key(&out[i & BENCH_POOL_MASK], c->seed + i);
+        }
+        break;
+    case HC_OP_ENCRYPT:
+        for (size_t i = 0; i < n; i++) {
+            size_t b = i & (BENCH_BUFFERS - 1);
+            hypercomplex_encrypt(c->plain[b], &c->key, c->scratch[b], c->padded);
+        }
+        break;
+    case HC_OP_ENCRYPT_DATA:
+        for (size_t i = 0; i < n; i++) {
+            size_t b = i & (BENCH_BUFFERS - 1);
+            size_t length = c->cipher_length;
+            hypercomplex_encrypt_data(c->plain[b], c->payload, &c->key, c->cipher[b], &length);
+        }
+        break;
+    case HC_OP_DECRYPT_DATA:
+        for (size_t i = 0; i < n; i++) {
+            size_t b = i & (BENCH_BUFFERS - 1);
+            size_t length = c->padded;
+            hypercomplex_decrypt_data(c->cipher[b], c->cipher_length, &c->key, c->scratch[b], &length);
+        }
+        break;
+    case HC_OP_MULTIPLY_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_multiply_batch(in, operands, out, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_ADD_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_add_batch(in, operands, out, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_CONJUGATE_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_conjugate_batch(in, out, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    case HC_OP_NORMALIZE_BATCH:
+        for (size_t i = 0; i < n; i++) {
+            quaternion_normalize_batch(in, out, HC_BENCH_BATCH_COUNT);
+        }
+        break;
+    default:
+        break;
+    }
+    
+    bench_escape(out);
+    bench_sink = (float)valid;
+}
+
+static size_t bench_bytes_per_op(const bench_ctx_t* c, hc_op_t op) {
+    switch (op) {
+    case HC_OP_MULTIPLY:
+    case HC_OP_ADD:
+        return 2 * sizeof(quaternion_t);
+    case HC_OP_ENCRYPT:
+        return c->padded;
+    case HC_OP_ENCRYPT_DATA:
+    case HC_OP_DECRYPT_DATA:
+        return c->payload;
+    case HC_OP_MULTIPLY_BATCH:
+    case HC_OP_ADD_BATCH:
+        return 2 * HC_BENCH_BATCH_COUNT * sizeof(quaternion_t);
+    case HC_OP_CONJUGATE_BATCH:
+    case HC_OP_NORMALIZE_BATCH:
+        return HC_BENCH_BATCH_COUNT * sizeof(quaternion_t);
+    default:
+        return sizeof(quaternion_t);
+    }
+}
+
+static uint64_t bench_add_chain(uint64_t rounds) {
+    uint64_t x = rounds;
+    
+    // Four dependent single-cycle adds per round; the empty asm blocks folding
+    for (uint64_t i = 0; i < rounds; i++) {
+        x += i; __asm__ __volatile__("" : "+r"(x));
+        x += i; __asm__ __volatile__("" : "+r"(x));
+        x += i; __asm__ __volatile__("" : "+r"(x));
+        x += i; __asm__ __volatile__("" : "+r"(x));
+    }
+    
+    return x;
+}
+
+double hc_bench_cpu_ghz(void) {
+    static double ghz = 0.0;
+    if (ghz > 0.0) return ghz;
+    
+    const uint64_t rounds = 5000000;
+    double best = 0.0;
+    
+    // First pass lets the core leave its idle frequency
+    bench_sink = (float)bench_add_chain(rounds);
+    
+    for (int trial = 0; trial < 3; trial++) {
+        uint64_t start = hc_now_ns();
+        uint64_t x = bench_add_chain(rounds);
+        uint64_t elapsed_ns = hc_now_ns() - start;
+        bench_sink = (float)x;
+        
+        double estimate = (double)(rounds * 4) / (double)(elapsed_ns ? elapsed_ns : 1);
+        if (estimate > best) best = estimate;
+    }
+    
+    ghz = best;
+    return ghz;
+}
+
+void hc_bench_default_config(hc_bench_config_t* config) {
+    if (!config) return;
+    
+    config->iterations = 100000;
+    config->repetitions = 10;
+    config->warmup = 100000;
+    config->payload_bytes = 4096;
+    config->seed = 0x5EEDULL;
+    config->cpu = HC_BENCH_CPU_CURRENT;
+    config->hw_counters = 1;
+}
+
+const char* hc_op_name(hc_op_t op) {
+    static const char* const names[HC_OP_COUNT] = {
+        "multiply", "add", "conjugate", "norm", "normalize",
+        "is_valid", "generate_key", "encrypt", "encrypt_data", "decrypt_data",
+        "multiply_batch", "add_batch", "conjugate_batch", "normalize_batch"
+    };
+    
+    if ((unsigned)op >= HC_OP_COUNT) return "unknown";
+    return names[op];
+}
+
+const char* hc_bench_mode_name(hc_bench_mode_t mode) {
+    return mode == HC_BENCH_LATENCY ? "latency" : "throughput";
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Linear interpolation between the two closest ranks of a sorted sample
+static double bench_percentile(const double* sorted, size_t n, double p) {
+    double rank = p * (double)(n - 1);
+    size_t lower = (size_t)rank;
+    if (lower + 1 >= n) return sorted[n - 1];
+    
+    double fraction = rank - (double)lower;
+    return sorted[lower] + (sorted[lower + 1] - sorted[lower]) * fraction;
+}
+
+// Two-sided 95% Student's t critical values for 1..30 degrees of freedom
+static double bench_t95(size_t df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    
+    if (df == 0) return 0.0;
+    return df <= 30 ? table[df - 1] : 1.960;
+}
+
+// Spread comes from the n per-repetition means; the distribution from the m
+// latency samples when there are any, else from the means
+static void bench_summarize(double* means, size_t n, double* latencies, size_t m, perf_stats_t* stats) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += means[i];
+    double mean = sum / (double)n;
+    
+    double squares = 0.0;
+    for (size_t i = 0; i < n; i++) squares += (means[i] - mean) * (means[i] - mean);
+    
+    double* samples = latencies ? latencies : means;
+    if (!latencies) m = n;
+    qsort(samples, m, sizeof(double), bench_compare_double);
+    
+    stats->repetitions = n;
+    stats->samples = m;
+    stats->min_ns = samples[0];
+    stats->median_ns = bench_percentile(samples, m, 0.5);
+    stats->p90_ns = bench_percentile(samples, m, 0.9);
+    stats->p99_ns = bench_percentile(samples, m, 0.99);
+    stats->p999_ns = bench_percentile(samples, m, 0.999);
+    stats->stddev_ns = n > 1 ? sqrt(squares / (double)(n - 1)) : 0.0;
+    stats->ci95_ns = n > 1 ? bench_t95(n - 1) * stats->stddev_ns / sqrt((double)n) : 0.0;
+}
+
+typedef struct {
+#ifdef __linux__
+    cpu_set_t saved;
+#endif
+    int pinned;
+} bench_affinity_t;
+
+static int bench_pin(int cpu, bench_affinity_t* affinity) {
+    affinity->pinned = 0;
+    
+#ifdef __linux__
+    // The default follows the caller; a core it can't read is left unpinned
+    if (cpu == HC_BENCH_CPU_CURRENT) cpu = sched_getcpu();
+    if (cpu < 0) return HC_SUCCESS;
+    
+    cpu_set_t set;
+    
+    if (sched_getaffinity(0, sizeof(affinity->saved), &affinity->saved) != 0) return HC_ERROR_INVALID_DATA;
+    
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) return HC_ERROR_INVALID_DATA;
+    
+    affinity->pinned = 1;
+    return HC_SUCCESS;
+#else
+    return (cpu < 0) ? HC_SUCCESS : HC_ERROR_INVALID_DATA;
+#endif
+}
+
+static void bench_unpin(bench_affinity_t* affinity) {
+#ifdef __linux__
+    if (affinity->pinned) sched_setaffinity(0, sizeof(affinity->saved), &affinity->saved);
+#endif
+    affinity->pinned = 0;
+}
+
+// Runs `calls` back-to-back invocations of the code under test
+typedef void (*bench_body_t)(void* arg, size_t calls);
+
+// Times config->repetitions samples of `calls` invocations each; stats are per operation.
+// With sample_calls set, each repetition is also timed every sample_calls calls,
+// back to back, and the percentiles come from those shorter samples.
+static int bench_measure_sampled(bench_body_t body, void* arg, const hc_bench_config_t* config,
+                                 size_t calls, size_t ops_per_call, size_t bytes_per_call,
+                                 size_t sample_calls, perf_stats_t* stats) {
+    if (sample_calls == 0 || sample_calls >= calls) sample_calls = calls;
+    if (calls / sample_calls > HC_BENCH_MAX_SAMPLES) {
+        sample_calls = (calls + HC_BENCH_MAX_SAMPLES - 1) / HC_BENCH_MAX_SAMPLES;
+    }
+    size_t per_repetition = (calls + sample_calls - 1) / sample_calls;
+    
+    double* samples = malloc(config->repetitions * sizeof(double));
+    double* latencies = per_repetition > 1 ? malloc(config->repetitions * per_repetition * sizeof(double)) : NULL;
+    if (!samples || (per_repetition > 1 && !latencies)) {
+        free(samples);
+        free(latencies);
+        return HC_ERROR_NO_MEMORY;
+    }
+    
+    double ghz = hc_bench_cpu_ghz();
+    size_t ops_per_sample = calls * ops_per_call;
+    
+    hc_perf_session_t perf;
+    int have_perf = config->hw_counters && hc_perf_open(&perf) == HC_SUCCESS;
+    if (have_perf) hc_perf_start(&perf);
+    
+    uint64_t total_ns = 0;
+    size_t m = 0;
+    for (size_t r = 0; r < config->repetitions; r++) {
+        uint64_t start = hc_now_ns();
+        uint64_t mark = start;
+        
+        for (size_t done = 0; done < calls; ) {
+            size_t n = calls - done < sample_calls ? calls - done : sample_calls;
+            body(arg, n);
+            
+            uint64_t now = hc_now_ns();
+            if (latencies) latencies[m++] = (double)(now - mark) / (double)(n * ops_per_call);
+            mark = now;
+            done += n;
+        }
+        uint64_t elapsed_ns = mark - start;
+        
+        samples[r] = (double)elapsed_ns / (double)ops_per_sample;
+        total_ns += elapsed_ns;
+    }
+    if (total_ns == 0) total_ns = 1;
+    
+    memset(&stats->hw, 0, sizeof(stats->hw));
+    if (have_perf) {
+        hc_perf_stop(&perf, &stats->hw);
+        hc_perf_close(&perf);
+    }
+    
+    size_t total_ops = ops_per_sample * config->repetitions;
+    stats->operations_per_second = (uint64_t)((double)total_ops * 1e9 / (double)total_ns);
+    stats->average_latency_ns = (double)total_ns / (double)total_ops;
+    stats->bytes_processed = calls * config->repetitions * bytes_per_call;
+    stats->operations = total_ops;
+    stats->cycles_per_op = (stats->hw.available & (1u << HC_COUNTER_CYCLES))
+        ? (double)stats->hw.values[HC_COUNTER_CYCLES] / (double)total_ops
+        : stats->average_latency_ns * ghz;
+    bench_summarize(samples, config->repetitions, latencies, m, stats);
+    
+    free(samples);
+    free(latencies);
+    return HC_SUCCESS;
+}
+
+static int bench_measure(bench_body_t body, void* arg, const hc_bench_config_t* config,
+                         size_t calls, size_t ops_per_call, size_t bytes_per_call,
+                         perf_stats_t* stats) {
+    return bench_measure_sampled(body, arg, config, calls, ops_per_call, bytes_per_call, 0, stats);
+}
+
+typedef struct {
+    bench_ctx_t* ctx;
+    hc_op_t op;
+    hc_bench_mode_t mode;
+} bench_job_t;
+
+static void bench_job_body(void* arg, size_t calls) {
+    bench_job_t* job = (bench_job_t*)arg;
+    
+    if (job->mode == HC_BENCH_LATENCY) {
+        bench_chain(job->ctx, job->op, calls);
+    } else {
+        bench_stream(job->ctx, job->op, calls);
+    }
+}
+
+int hc_bench_run(hc_op_t op, hc_bench_mode_t mode,
+                 const hc_bench_config_t* config, perf_stats_t* stats) {
+    if (!stats) return HC_ERROR_NULL_PTR;
+    
+    hc_bench_config_t defaults;
+    if (!config) {
+        hc_bench_default_config(&defaults);
+        config = &defaults;
+    }
+    
+    if ((unsigned)op >= HC_OP_COUNT ||
+        (mode != HC_BENCH_LATENCY && mode != HC_BENCH_THROUGHPUT) ||
+        config->iterations == 0 || config->repetitions == 0 || config->payload_bytes == 0) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    bench_affinity_t affinity;
+    if (bench_pin(config->cpu, &affinity) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+    
+    bench_ctx_t ctx;
+    int ret = bench_setup(&ctx, config);
+    
+    if (ret == HC_SUCCESS) {
+        bench_job_t job = { &ctx, op, mode };
+        
+        bench_job_body(&job, config->warmup);
+        ret = bench_measure_sampled(bench_job_body, &job, config, config->iterations, 1, bench_bytes_per_op(&ctx, op),
+                                    mode == HC_BENCH_LATENCY ? HC_BENCH_LATENCY_CALLS : 0, stats);
+        
+        bench_teardown(&ctx);
+    }
+    
+    bench_unpin(&affinity);
+    return ret;
+}
+
+/*
+ * Working-set sweep
+ */
+
+static size_t cache_sizes[4];
+static int cache_sizes_known;
+
+// Parses sysfs sizes such as "48K" or "32M"
+static size_t parse_cache_size(const char* text) {
+    char* end;
+    size_t size = (size_t)strtoull(text, &end, 10);
+    
+    if (*end == 'K') size <<= 10;
+    else if (*end == 'M') size <<= 20;
+    
+    return size;
+}
+
+static void detect_cache_sizes(void) {
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    cache_sizes[1] = l1 > 0 ? (size_t)l1 : 0;
+    cache_sizes[2] = l2 > 0 ? (size_t)l2 : 0;
+    cache_sizes[3] = l3 > 0 ? (size_t)l3 : 0;
+#endif
+    
+    // glibc reports 0 on many ARM64 systems; sysfs has the answer there
+    for (int index = 0; index < 8; index++) {
+        char path[96], level_text[16] = "", type[32] = "", size_text[32] = "";
+        FILE* f;
+        
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        if (!(f = fopen(path, "r"))) break;
+        if (!fgets(level_text, sizeof(level_text), f)) level_text[0] = '\0';
+        fclose(f);
+        
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        if ((f = fopen(path, "r"))) {
+            if (!fgets(type, sizeof(type), f)) type[0] = '\0';
+            fclose(f);
+        }
+        
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if ((f = fopen(path, "r"))) {
+            if (!fgets(size_text, sizeof(size_text), f)) size_text[0] = '\0';
+            fclose(f);
+        }
+        
+        int level = atoi(level_text);
+        if (level < 1 || level > 3 || strncmp(type, "Instruction", 11) == 0) continue;
+        if (cache_sizes[level] == 0) cache_sizes[level] = parse_cache_size(size_text);
+    }
+    
+    cache_sizes_known = 1;
+}
+
+size_t hc_cache_size(int level) {
+    if (level < 1 || level > 3) return 0;
+    if (!cache_sizes_known) detect_cache_sizes();
+    
+    return cache_sizes[level];
+}
+
+int hc_cache_level(size_t working_set_bytes) {
+    for (int level = 1; level <= 3; level++) {
+        if (working_set_bytes <= hc_cache_size(level)) return level;
+    }
+    
+    return 4;
+}
+
+typedef struct {
+    hc_op_t op;
+    const quaternion_t* a;
+    const quaternion_t* b;
+    quaternion_t* out;
+    size_t elements;
+    quaternion_t key;
+} sweep_job_t;
+
+static void sweep_body(void* arg, size_t passes) {
+    sweep_job_t* job = (sweep_job_t*)arg;
+    
+    for (size_t p = 0; p < passes; p++) {
+        switch (job->op) {
+        case HC_OP_MULTIPLY_BATCH:
+            quaternion_multiply_batch(job->a, job->b, job->out, job->elements);
+            break;
+        case HC_OP_ADD_BATCH:
+            quaternion_add_batch(job->a, job->b, job->out, job->elements);
+            break;
+        case HC_OP_CONJUGATE_BATCH:
+            quaternion_conjugate_batch(job->a, job->out, job->elements);
+            break;
+        case HC_OP_NORMALIZE_BATCH:
+            quaternion_normalize_batch(job->a, job->out, job->elements);
+            break;
+        default:
+            hypercomplex_encrypt(job->a, &job->key, job->out, job->elements * sizeof(quaternion_t));
+            break;
+        }
+    }
+    
+    bench_escape(job->out);
+}
+
+static int sweep_point(hc_op_t op, const hc_bench_config_t* config, size_t working_set,
+                       perf_stats_t* stats) {
+    int two_inputs = (op == HC_OP_MULTIPLY_BATCH || op == HC_OP_ADD_BATCH);
+    size_t arrays = two_inputs ? 3 : 2;
+    size_t elements = working_set / arrays / sizeof(quaternion_t);
+    size_t bytes = elements * sizeof(quaternion_t);
+    if (elements == 0) return HC_ERROR_INVALID_DATA;
+    
+    sweep_job_t job = { op, NULL, NULL, NULL, elements, { 1.0f, 0.0f, 0.0f, 0.0f } };
+    quaternion_t* a = hc_aligned_alloc(bytes, 64);
+    quaternion_t* b = two_inputs ? hc_aligned_alloc(bytes, 64) : NULL;
+    quaternion_t* out = hc_aligned_alloc(bytes, 64);
+    int ret = HC_ERROR_NO_MEMORY;
+    
+    if (a && out && (b || !two_inputs)) {
+        uint64_t state = config->seed;
+        
+        // Writing every element also faults the pages in before timing
+        for (size_t i = 0; i < elements; i++) {
+            bench_random_quaternion(&a[i], &state);
+            if (b) bench_random_quaternion(&b[i], &state);
+        }
+        memset(out, 0, bytes);
+        quaternion_generate_key(&job.key, bench_next_random(&state));
+        
+        job.a = a;
+        job.b = b;
+        job.out = out;
+        
+        // Small working sets repeat passes so each sample spans at least 1 MB of traffic
+        size_t passes = (working_set < (1u << 20)) ? (1u << 20) / working_set : 1;
+        
+        sweep_body(&job, 1);
+        ret = bench_measure(sweep_body, &job, config, passes, elements, arrays * bytes, stats);
+    }
+    
+    hc_aligned_free(a);
+    hc_aligned_free(b);
+    hc_aligned_free(out);
+    return ret;
+}
+
+int hc_bench_sweep(hc_op_t op, const hc_bench_config_t* config,
+                   size_t min_bytes, size_t max_bytes,
+                   hc_bench_result_t* results, size_t capacity, size_t* count) {
+    if (!results || !count) return HC_ERROR_NULL_PTR;
+    
+    hc_bench_config_t defaults;
+    if (!config) {
+        hc_bench_default_config(&defaults);
+        config = &defaults;
+    }
+    
+    *count = 0;
+    if ((op != HC_OP_ENCRYPT && op != HC_OP_MULTIPLY_BATCH && op != HC_OP_ADD_BATCH &&
+         op != HC_OP_CONJUGATE_BATCH && op != HC_OP_NORMALIZE_BATCH) ||
+        config->repetitions == 0 || min_bytes == 0 || min_bytes > max_bytes) {
+        return HC_ERROR_INVALID_DATA;
+    }
+    
+    bench_affinity_t affinity;
+    if (bench_pin(config->cpu, &affinity) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+    
+    int ret = HC_SUCCESS;
+    for (size_t ws = min_bytes; ws <= max_bytes && *count < capacity; ws *= 2) {
+        hc_bench_result_t* r = &results[*count];
+        r->op = op;
+        r->mode = HC_BENCH_THROUGHPUT;
+        r->payload_bytes = ws;
+        r->backend = NULL;
+        
+        ret = sweep_point(op, config, ws, &r->stats);
+        if (ret != HC_SUCCESS) break;
+        (*count)++;
+        
+        if (ws > max_bytes / 2) break;
+    }
+    
+    bench_unpin(&affinity);
+    
+    // Running out of memory at the top of the range still leaves a usable sweep
+    if (ret == HC_ERROR_NO_MEMORY && *count > 0) ret = HC_SUCCESS;
+    return ret;
+}
+
+static const char* bench_backend_name(const hc_bench_result_t* result) {
+    return result->backend ? result->backend : "default";
+}
+
+// Bytes moved per core cycle over the whole measurement
+static double bench_bytes_per_cycle(const perf_stats_t* stats) {
+    double cycles = stats->cycles_per_op * (double)stats->operations;
+    return cycles > 0.0 ? (double)stats->bytes_processed / cycles : 0.0;
+}
+
+// Counter total per measured operation, or -1 when the counter was not read
+static double bench_counter_per_op(const perf_stats_t* stats, hc_counter_t counter) {
+    if (!(stats->hw.available & (1u << counter)) || stats->operations == 0) return -1.0;
+    return (double)stats->hw.values[counter] / (double)stats->operations;
+}
+
+int hc_bench_write_json(FILE* out, const hc_bench_result_t* results, size_t count) {
+    if (!out || (!results && count > 0)) return HC_ERROR_NULL_PTR;
+    
+    fprintf(out, "{\n  \"cpu_ghz\": %.3f,\n  \"results\": [", hc_bench_cpu_ghz());
+    
+    for (size_t i = 0; i < count; i++) {
+        const perf_stats_t* st = &results[i].stats;
+        fprintf(out,
+                "%s\n    {\"op\": \"%s\", \"mode\": \"%s\", \"backend\": \"%s\", \"payload_bytes\": %zu, "
+                "\"repetitions\": %zu, \"samples\": %zu, \"ops_per_second\": %llu, \"mean_ns\": %.4f, "
+                "\"cycles_per_op\": %.4f, \"min_ns\": %.4f, \"median_ns\": %.4f, "
+                "\"p90_ns\": %.4f, \"p99_ns\": %.4f, \"p999_ns\": %.4f, "
+                "\"stddev_ns\": %.4f, \"ci95_ns\": %.4f, \"bytes_processed\": %zu, "
+                "\"bytes_per_cycle\": %.4f",
+                i ? "," : "", hc_op_name(results[i].op), hc_bench_mode_name(results[i].mode),
+                bench_backend_name(&results[i]), results[i].payload_bytes, st->repetitions, st->samples,
+                (unsigned long long)st->operations_per_second, st->average_latency_ns,
+                st->cycles_per_op, st->min_ns, st->median_ns, st->p90_ns, st->p99_ns,
+                st->p999_ns, st->stddev_ns, st->ci95_ns, st->bytes_processed,
+                bench_bytes_per_cycle(st));
+        
+        // Counters that could not be read are reported as null
+        for (int c = 0; c < HC_COUNTER_COUNT; c++) {
+            double per_op = bench_counter_per_op(st, (hc_counter_t)c);
+            if (per_op < 0.0) {
+                fprintf(out, ", \"%s_per_op\": null", hc_counter_name((hc_counter_t)c));
+            } else {
+                fprintf(out, ", \"%s_per_op\": %.4f", hc_counter_name((hc_counter_t)c), per_op);
+            }
+        }
+        fprintf(out, "}");
+    }
+    
+    fprintf(out, "\n  ]\n}\n");
+    return ferror(out) ? HC_ERROR_INVALID_DATA : HC_SUCCESS;
+}
+
+int hc_bench_write_csv(FILE* out, const hc_bench_result_t* results, size_t count) {
+    if (!out || (!results && count > 0)) return HC_ERROR_NULL_PTR;
+    
+    fprintf(out, "op,mode,backend,payload_bytes,repetitions,samples,ops_per_second,mean_ns,cycles_per_op,"
+                 "min_ns,median_ns,p90_ns,p99_ns,p999_ns,stddev_ns,ci95_ns,bytes_processed,"
+                 "bytes_per_cycle");
+    for (int c = 0; c < HC_COUNTER_COUNT; c++) {
+        fprintf(out, ",%s_per_op", hc_counter_name((hc_counter_t)c));
+    }
+    fprintf(out, "\n");
+    
+    for (size_t i = 0; i < count; i++) {
+        const perf_stats_t* st = &results[i].stats;
+        fprintf(out, "%s,%s,%s,%zu,%zu,%zu,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%zu,%.4f",
+                hc_op_name(results[i].op), hc_bench_mode_name(results[i].mode),
+                bench_backend_name(&results[i]), results[i].payload_bytes, st->repetitions, st->samples,
+                (unsigned long long)st->operations_per_second, st->average_latency_ns,
+                st->cycles_per_op, st->min_ns, st->median_ns, st->p90_ns, st->p99_ns,
+                st->p999_ns, st->stddev_ns, st->ci95_ns, st->bytes_processed,
+                bench_bytes_per_cycle(st));
+        
+        // Counters that could not be read are left empty
+        for (int c = 0; c < HC_COUNTER_COUNT; c++) {
+            double per_op = bench_counter_per_op(st, (hc_counter_t)c);
+            if (per_op < 0.0) {
+                fprintf(out, ",");
+            } else {
+                fprintf(out, ",%.4f", per_op);
+            }
+        }
+        fprintf(out, "\n");
+    }
+    
+    return ferror(out) ? HC_ERROR_INVALID_DATA : HC_SUCCESS;
+}
+
+/*
+ * Baselines and regression comparison
+ */
+
+// Splits a CSV line in place, keeping empty fields; returns the field count
+static size_t baseline_split(char* line, char** fields, size_t max_fields) {
+    size_t n = 0;
+    
+    line[strcspn(line, "\r\n")] = '\0';
+    while (n < max_fields) {
+        fields[n++] = line;
+        char* comma = strchr(line, ',');
+        if (!comma) break;
+        *comma = '\0';
+        line = comma + 1;
+    }
+    
+    return n;
+}
+
+static int baseline_column(char** fields, size_t n, const char* name) {
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(fields[i], name) == 0) return (int)i;
+    }
+    
+    return -1;
+}
+
+int hc_bench_read_baseline(FILE* in, hc_bench_baseline_t** entries, size_t* count) {
+    if (!in || !entries || !count) return HC_ERROR_NULL_PTR;
+    
+    enum { MAX_FIELDS = 64 };
+    char line[2048];
+    char* fields[MAX_FIELDS];
+    
+    *entries = NULL;
+    *count = 0;
+    
+    if (!fgets(line, sizeof(line), in)) return HC_ERROR_INVALID_DATA;
+    size_t columns = baseline_split(line, fields, MAX_FIELDS);
+    
+    int col_op = baseline_column(fields, columns, "op");
+    int col_mode = baseline_column(fields, columns, "mode");
+    int col_backend = baseline_column(fields, columns, "backend");
+    int col_payload = baseline_column(fields, columns, "payload_bytes");
+    int col_reps = baseline_column(fields, columns, "repetitions");
+    int col_mean = baseline_column(fields, columns, "mean_ns");
+    int col_stddev = baseline_column(fields, columns, "stddev_ns");
+    if (col_op < 0 || col_mode < 0 || col_payload < 0 || col_mean < 0) return HC_ERROR_INVALID_DATA;
+    
+    size_t capacity = 0;
+    while (fgets(line, sizeof(line), in)) {
+        if (baseline_split(line, fields, MAX_FIELDS) < columns) continue;
+        
+        hc_bench_baseline_t entry;
+        memset(&entry, 0, sizeof(entry));
+        
+        // Rows for operations this build doesn't know are skipped
+        entry.op = HC_OP_COUNT;
+        for (int op = 0; op < HC_OP_COUNT; op++) {
+            if (strcmp(fields[col_op], hc_op_name((hc_op_t)op)) == 0) entry.op = (hc_op_t)op;
+        }
+        if (entry.op == HC_OP_COUNT) continue;
+        
+        entry.mode = strcmp(fields[col_mode], hc_bench_mode_name(HC_BENCH_LATENCY)) == 0
+            ? HC_BENCH_LATENCY : HC_BENCH_THROUGHPUT;
+        snprintf(entry.backend, sizeof(entry.backend), "%s",
+                 col_backend >= 0 ? fields[col_backend] : "default");
+        entry.payload_bytes = (size_t)strtoull(fields[col_payload], NULL, 10);
+        entry.repetitions = col_reps >= 0 ? (size_t)strtoull(fields[col_reps], NULL, 10) : 1;
+        entry.mean_ns = strtod(fields[col_mean], NULL);
+        entry.stddev_ns = col_stddev >= 0 ? strtod(fields[col_stddev], NULL) : 0.0;
+        
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            hc_bench_baseline_t* grown = realloc(*entries, capacity * sizeof(*grown));
+            if (!grown) {
+                free(*entries);
+                *entries = NULL;
+                *count = 0;
+                return HC_ERROR_NO_MEMORY;
+            }
+            *entries = grown;
+        }
+        (*entries)[(*count)++] = entry;
+    }
+    
+    return HC_SUCCESS;
+}
+
+// Welch's t-test: is the current mean slower than the baseline at 95% confidence?
+static int baseline_significant(double mean, double stddev, size_t n,
+                                double base_mean, double base_stddev, size_t base_n,
+                                double* t_statistic) {
+    double v1 = n > 1 ? stddev * stddev / (double)n : 0.0;
+    double v2 = base_n > 1 ? base_stddev * base_stddev / (double)base_n : 0.0;
+    double se = sqrt(v1 + v2);
+    
+    // Without spread information the threshold alone decides
+    if (se <= 0.0) {
+        *t_statistic = 0.0;
+        return 1;
+    }
+    
+    *t_statistic = (mean - base_mean) / se;
+    
+    double df_denominator = (n > 1 ? v1 * v1 / (double)(n - 1) : 0.0) +
+                            (base_n > 1 ? v2 * v2 / (double)(base_n - 1) : 0.0);
+    size_t df = df_denominator > 0.0 ? (size_t)((v1 + v2) * (v1 + v2) / df_denominator) : 1;
+    if (df == 0) df = 1;
+    
+    return *t_statistic > bench_t95(df);
+}
+
+int hc_bench_compare(FILE* report, const hc_bench_result_t* results, size_t count,
+                     const hc_bench_baseline_t* baseline, size_t baseline_count,
+                     double threshold_pct, size_t* regressions) {
+    if ((!results && count > 0) || (!baseline && baseline_count > 0) || !regressions) {
+        return HC_ERROR_NULL_PTR;
+    }
+    
+    *regressions = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        const hc_bench_result_t* r = &results[i];
+        const hc_bench_baseline_t* base = NULL;
+        
+        for (size_t j = 0; j < baseline_count && !base; j++) {
+            if (baseline[j].op == r->op && baseline[j].mode == r->mode &&
+                baseline[j].payload_bytes == r->payload_bytes &&
+                strcmp(baseline[j].backend, bench_backend_name(r)) == 0) {
+                base = &baseline[j];
+            }
+        }
+        
+        if (report) {
+            fprintf(report, "  %-16s %-10s %-8s %10zu  ", hc_op_name(r->op),
+                    hc_bench_mode_name(r->mode), bench_backend_name(r), r->payload_bytes);
+        }
+        if (!base || base->mean_ns <= 0.0) {
+            if (report) fprintf(report, "not in baseline\n");
+            continue;
+        }
+        
+        double t = 0.0;
+        double change = (r->stats.average_latency_ns - base->mean_ns) / base->mean_ns * 100.0;
+        int significant = baseline_significant(r->stats.average_latency_ns, r->stats.stddev_ns,
+                                               r->stats.repetitions, base->mean_ns,
+                                               base->stddev_ns, base->repetitions, &t);
+        int regressed = change > threshold_pct && significant;
+        if (regressed) (*regressions)++;
+        
+        if (report) {
+            fprintf(report, "%10.3f -> %10.3f ns/op %+7.2f%% (t=%.2f)%s\n",
+                    base->mean_ns, r->stats.average_latency_ns, change, t,
+                    regressed ? "  REGRESSION" : "");
+        }
+    }
+    
+    return HC_SUCCESS;
+}
+
+/*
+ * Backend comparison
  */
-int hypercomplex_decrypt_data(const void* ciphertext, size_t cipher_length,
-                             const quaternion_t* key, void* plaintext,
-                             size_t* plain_length);
 
-/**
- * Performance benchmarking
- */
 typedef struct {
-    uint64_t operations_per_second;
-    double average_latency_ns;
-    size_t bytes_processed;
-} perf_stats_t;
+    backend_fn_t fn;
+    const quaternion_t* a;
+    const quaternion_t* b;
+    quaternion_t* out;
+    size_t elements;
+} backend_job_t;
 
-int hypercomplex_benchmark(size_t iterations, perf_stats_t* stats);
+static void backend_body(void* arg, size_t passes) {
+    backend_job_t* job = (backend_job_t*)arg;
+    
+    for (size_t p = 0; p < passes; p++) {
+        job->fn(job->a, job->b, job->out, job->elements);
+        bench_escape(job->out);
+    }
+}
 
-#ifdef __cplusplus
+static float backend_max_error(hc_kernel_t kernel, const quaternion_t* out,
+                               const quaternion_t* reference, size_t elements) {
+    const float* x = (const float*)out;
+    const float* y = (const float*)reference;
+    size_t floats = (kernel == HC_KERNEL_NORM) ? elements : elements * 4;
+    float worst = 0.0f;
+    
+    for (size_t i = 0; i < floats; i++) {
+        float diff = fabsf(x[i] - y[i]);
+        if (!(diff <= worst)) worst = diff;      // NaN sticks
+    }
+    
+    return worst;
 }
-#endif
 
-#endif /* HYPERCOMPLEX_H */
+// Times every available backend of every kernel over the prepared arrays
+static int backend_run_all(const hc_bench_config_t* config, const quaternion_t* a,
+                           const quaternion_t* b, quaternion_t* out, quaternion_t* reference,
+                           hc_backend_result_t* results, size_t capacity, size_t* count) {
+    const size_t elements = HC_BENCH_BATCH_COUNT;
+    const size_t bytes = elements * sizeof(quaternion_t);
+    size_t passes = config->iterations / elements;
+    if (passes == 0) passes = 1;
+    
+    for (int k = 0; k < HC_KERNEL_COUNT; k++) {
+        int binary = (k == HC_KERNEL_MULTIPLY || k == HC_KERNEL_ADD);
+        size_t out_bytes = (k == HC_KERNEL_NORM) ? elements * sizeof(float) : bytes;
+        
+        memset(reference, 0, bytes);
+        backend_table[HC_BACKEND_SCALAR][k](a, b, reference, elements);
+        
+        for (int be = 0; be < HC_BACKEND_COUNT; be++) {
+            if (!backend_table[be][k]) continue;
+            if (*count >= capacity) return HC_SUCCESS;
+            
+            hc_backend_result_t* r = &results[*count];
+            backend_job_t job = { backend_table[be][k], a, b, out, elements };
+            
+            r->kernel = (hc_kernel_t)k;
+            r->backend = (hc_backend_t)be;
+            
+            // The check pass doubles as warm-up
+            memset(out, 0, bytes);
+            backend_body(&job, 1);
+            r->max_error = backend_max_error(r->kernel, out, reference, elements);
+            
+            int ret = bench_measure(backend_body, &job, config, passes, elements,
+                                    (binary ? 2 : 1) * bytes + out_bytes, &r->stats);
+            if (ret != HC_SUCCESS) return ret;
+            (*count)++;
+        }
+    }
+    
+    return HC_SUCCESS;
+}
+
+int hc_bench_backends(const hc_bench_config_t* config, hc_backend_result_t* results,
+                      size_t capacity, size_t* count) {
+    if (!results || !count) return HC_ERROR_NULL_PTR;
+    
+    hc_bench_config_t defaults;
+    if (!config) {
+        hc_bench_default_config(&defaults);
+        config = &defaults;
+    }
+    
+    *count = 0;
+    if (config->iterations == 0 || config->repetitions == 0) return HC_ERROR_INVALID_DATA;
+    
+    bench_affinity_t affinity;
+    if (bench_pin(config->cpu, &affinity) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+    
+    size_t bytes = HC_BENCH_BATCH_COUNT * sizeof(quaternion_t);
+    quaternion_t* a = hc_aligned_alloc(bytes, 64);
+    quaternion_t* b = hc_aligned_alloc(bytes, 64);
+    quaternion_t* out = hc_aligned_alloc(bytes, 64);
+    quaternion_t* reference = hc_aligned_alloc(bytes, 64);
+    int ret = HC_ERROR_NO_MEMORY;
+    
+    if (a && b && out && reference) {
+        uint64_t state = config->seed;
+        
+        // Unit operands, inputs scaled off the unit sphere so normalize has work to do
+        for (size_t i = 0; i < HC_BENCH_BATCH_COUNT; i++) {
+            float scale = 0.5f + 2.0f * (bench_random_float(&state) + 1.0f);
+            bench_random_quaternion(&a[i], &state);
+            bench_random_quaternion(&b[i], &state);
+            a[i].w *= scale; a[i].x *= scale; a[i].y *= scale; a[i].z *= scale;
+        }
+        
+        ret = backend_run_all(config, a, b, out, reference, results, capacity, count);
+    }
+    
+    hc_aligned_free(a);
+    hc_aligned_free(b);
+    hc_aligned_free(out);
+    hc_aligned_free(reference);
+    bench_unpin(&affinity);
+    return ret;
+}
+
+int hc_bench_print_backends(FILE* out, const hc_backend_result_t* results, size_t count) {
+    if (!out || (!results && count > 0)) return HC_ERROR_NULL_PTR;
+    
+    fprintf(out, "  %-10s %-8s %10s %10s %10s %8s %10s\n",
+            "Kernel", "Backend", "ns/quat", "cyc/quat", "ins/quat", "speedup", "max err");
+    
+    for (size_t i = 0; i < count; i++) {
+        const hc_backend_result_t* r = &results[i];
+        const perf_stats_t* st = &r->stats;
+        double scalar_ns = 0.0;
+        char instructions[16] = "-";
+        
+        for (size_t j = 0; j < count; j++) {
+            if (results[j].kernel == r->kernel && results[j].backend == HC_BACKEND_SCALAR) {
+                scalar_ns = results[j].stats.average_latency_ns;
+            }
+        }
+        
+        double per_op = bench_counter_per_op(st, HC_COUNTER_INSTRUCTIONS);
+        if (per_op >= 0.0) snprintf(instructions, sizeof(instructions), "%.2f", per_op);
+        
+        fprintf(out, "  %-10s %-8s %10.3f %10.3f %10s %7.2fx %10.2e\n",
+                hc_kernel_name(r->kernel), hc_backend_name(r->backend),
+                st->average_latency_ns, st->cycles_per_op, instructions,
+                st->average_latency_ns > 0.0 ? scalar_ns / st->average_latency_ns : 0.0,
+                (double)r->max_error);
+    }
+    
+    return HC_SUCCESS;
+}
 
 /*
- * Implementation file: hypercomplex.c
+ * Roofline
  */
 
-#include "hypercomplex.h"
-#include <math.h>
-#include <string.h>
-#include <time.h>
+#define ROOFLINE_PEAK_STEPS 1024
 
-int quaternion_is_valid(const quaternion_t* q) {
-    if (!q) return 0;
+int hc_kernel_cost(hc_kernel_t kernel, hc_kernel_cost_t* cost) {
+    if (!cost) return HC_ERROR_NULL_PTR;
     
-    return (isfinite(q->w) && isfinite(q->x) && 
-            isfinite(q->y) && isfinite(q->z));
+    // Sign flips in conjugate count as flops, sqrt and divide as one each
+    switch (kernel) {
+    case HC_KERNEL_MULTIPLY: *cost = (hc_kernel_cost_t){ 28.0, 48.0 }; break;   // 16 mul, 12 add
+    case HC_KERNEL_ADD: *cost = (hc_kernel_cost_t){ 4.0, 48.0 }; break;
+    case HC_KERNEL_CONJUGATE: *cost = (hc_kernel_cost_t){ 3.0, 32.0 }; break;
+    case HC_KERNEL_NORM: *cost = (hc_kernel_cost_t){ 8.0, 20.0 }; break;        // 4 mul, 3 add, sqrt
+    case HC_KERNEL_NORMALIZE: *cost = (hc_kernel_cost_t){ 13.0, 32.0 }; break;  // norm, divide, 4 mul
+    default: return HC_ERROR_INVALID_DATA;
+    }
+    
+    return HC_SUCCESS;
 }
 
-void quaternion_generate_key(quaternion_t* key, uint64_t seed) {
-    if (!key) return;
+// Twelve independent multiply-add chains cover FP latency on current cores
+// without spilling the 16 SSE registers
+static void roofline_peak_body(void* arg, size_t passes) {
+    float* sink = (float*)arg;
     
-    // Simple PRNG based on seed
-    uint64_t state = seed;
+#if defined(HC_SIMD_NEON) || defined(HC_SIMD_SSE)
+#ifdef HC_SIMD_NEON
+    typedef float32x4_t vec_t;
+    const vec_t m = vdupq_n_f32(0.999f), c = vdupq_n_f32(1e-4f);
+#define ROOFLINE_STEP(v) v = vmlaq_f32(c, v, m)
+#define ROOFLINE_SUM(x, y) vaddq_f32(x, y)
+    vec_t v0 = vdupq_n_f32(*sink), v1 = v0, v2 = v0, v3 = v0, v4 = v0, v5 = v0;
+#else
+    typedef __m128 vec_t;
+    const vec_t m = _mm_set1_ps(0.999f), c = _mm_set1_ps(1e-4f);
+#define ROOFLINE_STEP(v) v = _mm_add_ps(_mm_mul_ps(v, m), c)
+#define ROOFLINE_SUM(x, y) _mm_add_ps(x, y)
+    vec_t v0 = _mm_set1_ps(*sink), v1 = v0, v2 = v0, v3 = v0, v4 = v0, v5 = v0;
+#endif
+    vec_t v6 = v0, v7 = v0, v8 = v0, v9 = v0, v10 = v0, v11 = v0;
     
-    // Linear congruential generator
-    state = state * 1103515245 + 12345;
-    key->w = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    for (size_t p = 0; p < passes; p++) {
+        for (int i = 0; i < ROOFLINE_PEAK_STEPS; i++) {
+            ROOFLINE_STEP(v0); ROOFLINE_STEP(v1); ROOFLINE_STEP(v2); ROOFLINE_STEP(v3);
+            ROOFLINE_STEP(v4); ROOFLINE_STEP(v5); ROOFLINE_STEP(v6); ROOFLINE_STEP(v7);
+            ROOFLINE_STEP(v8); ROOFLINE_STEP(v9); ROOFLINE_STEP(v10); ROOFLINE_STEP(v11);
+        }
+    }
     
-    state = state * 1103515245 + 12345;
-    key->x = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    vec_t total = ROOFLINE_SUM(ROOFLINE_SUM(ROOFLINE_SUM(v0, v1), ROOFLINE_SUM(v2, v3)),
+                               ROOFLINE_SUM(ROOFLINE_SUM(v4, v5), ROOFLINE_SUM(v6, v7)));
+    total = ROOFLINE_SUM(total, ROOFLINE_SUM(ROOFLINE_SUM(v8, v9), ROOFLINE_SUM(v10, v11)));
+    float lanes[4];
+    memcpy(lanes, &total, sizeof(lanes));
+    *sink = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#undef ROOFLINE_STEP
+#undef ROOFLINE_SUM
+#else
+    float v[48];
+    for (int j = 0; j < 48; j++) v[j] = *sink;
     
-    state = state * 1103515245 + 12345;
-    key->y = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    for (size_t p = 0; p < passes; p++) {
+        for (int i = 0; i < ROOFLINE_PEAK_STEPS; i++) {
+            for (int j = 0; j < 48; j++) v[j] = v[j] * 0.999f + 1e-4f;
+        }
+    }
     
-    state = state * 1103515245 + 12345;
-    key->z = (float)(state & 0xFFFF) / 65535.0f * 2.0f - 1.0f;
+    float total = 0.0f;
+    for (int j = 0; j < 48; j++) total += v[j];
+    *sink = total;
+#endif
+    bench_escape(sink);
+}
+
+typedef struct {
+    quaternion_t* a;
+    const quaternion_t* b;
+    const quaternion_t* c;
+    size_t elements;
+} roofline_stream_t;
+
+// Triad a quaternion at a time, shaped like the kernels so it vectorizes the same way
+static void roofline_stream_body(void* arg, size_t passes) {
+    roofline_stream_t* job = (roofline_stream_t*)arg;
     
-    // Normalize the key
-    quaternion_normalize(key, key);
+    for (size_t p = 0; p < passes; p++) {
+        for (size_t i = 0; i < job->elements; i++) {
+            const quaternion_t x = job->b[i];
+            const quaternion_t y = job->c[i];
+            quaternion_t r = { x.w + 3.0f * y.w, x.x + 3.0f * y.x, x.y + 3.0f * y.y, x.z + 3.0f * y.z };
+            job->a[i] = r;
+        }
+        bench_escape(job->a);
+    }
 }
 
-static uint32_t compute_checksum(const void* data, size_t length) {
-    const uint8_t* bytes = (const uint8_t*)data;
-    uint32_t checksum = 0;
+static int roofline_measure(const hc_bench_config_t* config, quaternion_t* a, quaternion_t* b,
+                            quaternion_t* out, size_t elements, hc_roofline_t* roofline) {
+    perf_stats_t stats;
+    float sink = 1.0f;
     
-    for (size_t i = 0; i < length; i++) {
-        checksum = (checksum << 1) ^ bytes[i];
+    // 12 chains x 4 lanes x (mul + add) per step
+    size_t peak_flops = (size_t)ROOFLINE_PEAK_STEPS * 12 * 4 * 2;
+    roofline_peak_body(&sink, 16);
+    int ret = bench_measure(roofline_peak_body, &sink, config, 256, peak_flops, 0, &stats);
+    if (ret != HC_SUCCESS) return ret;
+    roofline->peak_gflops = 1.0 / stats.average_latency_ns;
+    
+    roofline_stream_t stream = { out, a, b, elements };
+    roofline_stream_body(&stream, 1);
+    ret = bench_measure(roofline_stream_body, &stream, config, 1, elements,
+                        3 * sizeof(quaternion_t) * elements, &stats);
+    if (ret != HC_SUCCESS) return ret;
+    roofline->bandwidth_gbs = 3.0 * sizeof(quaternion_t) / stats.average_latency_ns;
+    
+    double ridge = roofline->peak_gflops / roofline->bandwidth_gbs;
+    
+    for (int k = 0; k < HC_KERNEL_COUNT; k++) {
+        for (int be = 0; be < HC_BACKEND_COUNT; be++) {
+            if (!backend_table[be][k]) continue;
+            if (roofline->count >= HC_KERNEL_COUNT * HC_BACKEND_COUNT) return HC_SUCCESS;
+            
+            hc_roofline_point_t* point = &roofline->points[roofline->count];
+            backend_job_t job = { backend_table[be][k], a, b, out, elements };
+            
+            point->kernel = (hc_kernel_t)k;
+            point->backend = (hc_backend_t)be;
+            hc_kernel_cost(point->kernel, &point->cost);
+            
+            backend_body(&job, 1);
+            ret = bench_measure(backend_body, &job, config, 1, elements,
+                                (size_t)point->cost.bytes * elements, &stats);
+            if (ret != HC_SUCCESS) return ret;
+            
+            point->intensity = point->cost.flops / point->cost.bytes;
+            point->gflops = point->cost.flops / stats.average_latency_ns;
+            point->memory_bound = point->intensity < ridge;
+            point->bound_gflops = point->memory_bound ? point->intensity * roofline->bandwidth_gbs
+                                                      : roofline->peak_gflops;
+            point->fraction = point->gflops / point->bound_gflops;
+            roofline->count++;
+        }
     }
     
-    return checksum;
+    return HC_SUCCESS;
 }
 
-int hypercomplex_encrypt_data(const void* plaintext, size_t length, 
-                             const quaternion_t* key, void* ciphertext, 
-                             size_t* cipher_length) {
-    if (!plaintext || !key || !ciphertext || !cipher_length) {
-        return HC_ERROR_NULL_PTR;
+int hc_bench_roofline(const hc_bench_config_t* config, size_t working_set_bytes,
+                      hc_roofline_t* roofline) {
+    if (!roofline) return HC_ERROR_NULL_PTR;
+    
+    hc_bench_config_t defaults;
+    if (!config) {
+        hc_bench_default_config(&defaults);
+        config = &defaults;
     }
+    if (config->repetitions == 0) return HC_ERROR_INVALID_DATA;
     
-    if (!quaternion_is_valid(key)) {
-        return HC_ERROR_INVALID_DATA;
+    if (working_set_bytes == 0) {
+        working_set_bytes = 4 * hc_cache_size(3);
+        if (working_set_bytes < ((size_t)64 << 20)) working_set_bytes = (size_t)64 << 20;
     }
     
-    // Calculate required cipher length
-    size_t header_size = sizeof(hypercomplex_header_t);
-    size_t padded_length = ((length + 15) / 16) * 16; // Align to 16 bytes
-    size_t total_size = header_size + padded_length;
+    // Two inputs and an output, which also serve as the stream arrays
+    size_t elements = working_set_bytes / 3 / sizeof(quaternion_t);
+    size_t bytes = elements * sizeof(quaternion_t);
+    if (elements == 0) return HC_ERROR_INVALID_DATA;
     
-    if (*cipher_length < total_size) {
-        *cipher_length = total_size;
-        return HC_ERROR_INVALID_DATA;
+    memset(roofline, 0, sizeof(*roofline));
+    roofline->working_set_bytes = 3 * bytes;
+    
+    bench_affinity_t affinity;
+    if (bench_pin(config->cpu, &affinity) != HC_SUCCESS) return HC_ERROR_INVALID_DATA;
+    
+    quaternion_t* a = hc_aligned_alloc(bytes, 64);
+    quaternion_t* b = hc_aligned_alloc(bytes, 64);
+    quaternion_t* out = hc_aligned_alloc(bytes, 64);
+    int ret = HC_ERROR_NO_MEMORY;
+    
+    if (a && b && out) {
+        uint64_t state = config->seed;
+        
+        // Writing every element also faults the pages in before timing
+        for (size_t i = 0; i < elements; i++) {
+            bench_random_quaternion(&a[i], &state);
+            bench_random_quaternion(&b[i], &state);
+        }
+        memset(out, 0, bytes);
+        
+        ret = roofline_measure(config, a, b, out, elements, roofline);
     }
     
-    // Create header
-    hypercomplex_header_t* header = (hypercomplex_header_t*)ciphertext;
-    header->magic = 0xDEADBEEF;
-    header->length = length;
-    header->key = *key;
-    header->checksum = compute_checksum(plaintext, length);
+    hc_aligned_free(a);
+    hc_aligned_free(b);
+    hc_aligned_free(out);
+    bench_unpin(&affinity);
+    return ret;
+}
+
+int hc_bench_print_roofline(FILE* out, const hc_roofline_t* roofline) {
+    if (!out || !roofline) return HC_ERROR_NULL_PTR;
     
-    // Prepare padded plaintext
-    uint8_t* padded_data = (uint8_t*)ciphertext + header_size;
-    memcpy(padded_data, plaintext, length);
+    fprintf(out, "  peak %.2f GFLOP/s, stream %.2f GB/s, ridge %.2f flop/byte, working set %zu MB\n",
+            roofline->peak_gflops, roofline->bandwidth_gbs,
+            roofline->peak_gflops / roofline->bandwidth_gbs, roofline->working_set_bytes >> 20);
+    fprintf(out, "  %-10s %-8s %9s %9s %9s %9s %9s %8s %8s\n",
+            "Kernel", "Backend", "flop/el", "byte/el", "flop/B", "GFLOP/s", "bound", "% bound", "limit");
     
-    // Zero-pad the remaining bytes
-    if (padded_length > length) {
-        memset(padded_data + length, 0, padded_length - length);
+    for (size_t i = 0; i < roofline->count; i++) {
+        const hc_roofline_point_t* p = &roofline->points[i];
+        fprintf(out, "  %-10s %-8s %9.1f %9.1f %9.3f %9.2f %9.2f %7.1f%% %8s\n",
+                hc_kernel_name(p->kernel), hc_backend_name(p->backend),
+                p->cost.flops, p->cost.bytes, p->intensity, p->gflops, p->bound_gflops,
+                100.0 * p->fraction, p->memory_bound ? "memory" : "compute");
     }
     
-    // Encrypt the data
-    int result = hypercomplex_encrypt(padded_data, key, padded_data, padded_length);
+    return HC_SUCCESS;
+}
+
+int hc_bench_write_roofline_csv(FILE* out, const hc_roofline_t* roofline) {
+    if (!out || !roofline) return HC_ERROR_NULL_PTR;
+    
+    fprintf(out, "kernel,backend,flops_per_element,bytes_per_element,intensity,gflops,"
+                 "bound_gflops,fraction,limit,peak_gflops,bandwidth_gbs,working_set_bytes\n");
     
-    if (result == HC_SUCCESS) {
-        *cipher_length = total_size;
+    for (size_t i = 0; i < roofline->count; i++) {
+        const hc_roofline_point_t* p = &roofline->points[i];
+        fprintf(out, "%s,%s,%.1f,%.1f,%.6f,%.6f,%.6f,%.6f,%s,%.6f,%.6f,%zu\n",
+                hc_kernel_name(p->kernel), hc_backend_name(p->backend),
+                p->cost.flops, p->cost.bytes, p->intensity, p->gflops, p->bound_gflops,
+                p->fraction, p->memory_bound ? "memory" : "compute",
+                roofline->peak_gflops, roofline->bandwidth_gbs, roofline->working_set_bytes);
     }
     
-    return result;
+    return ferror(out) ? HC_ERROR_INVALID_DATA : HC_SUCCESS;
 }
 
-int hypercomplex_decrypt_data(const void* ciphertext, size_t cipher_length,
-                             const quaternion_t* key, void* plaintext,
-                             size_t* plain_length) {
-    if (!ciphertext || !key || !plaintext || !plain_length) {
-        return HC_ERROR_NULL_PTR;
+/*
+ * Accuracy harness
+ */
+
+#define ACCURACY_CHUNK HC_BENCH_BATCH_COUNT
+
+typedef struct {
+    long double c[4];
+    long double scale;                       // Magnitude the error is measured against
+    int skip;                                // Outside the kernel's domain
+} accuracy_ref_t;
+
+double hc_accuracy_bound(hc_kernel_t kernel) {
+    // Sums of four rounded terms plus a final rounding, with headroom for fused vs unfused
+    switch (kernel) {
+    case HC_KERNEL_MULTIPLY: return 4.0;
+    case HC_KERNEL_ADD: return 0.5;
+    case HC_KERNEL_CONJUGATE: return 0.0;
+    case HC_KERNEL_NORM: return 2.5;
+    case HC_KERNEL_NORMALIZE: return 4.0;
+    default: return 0.0;
     }
+}
+
+// Spacing of floats around x; denormal spacing below FLT_MIN
+static long double accuracy_ulp(long double x) {
+    float f = fabsf((float)x);
+    if (f < 1.17549435e-38f) return ldexpl(1.0L, -149);
+    if (isinf(f)) f = 3.40282347e+38f;
+    return ldexpl(1.0L, ilogbf(f) - 23);
+}
+
+static float accuracy_component(uint64_t* state, int min_exp, int max_exp) {
+    float mantissa = 1.0f + (float)(bench_next_random(state) >> 41) / 8388608.0f;
+    int e = min_exp + (int)(bench_next_random(state) % (uint64_t)(max_exp - min_exp + 1));
+    return (bench_next_random(state) & 1) ? -ldexpf(mantissa, e) : ldexpf(mantissa, e);
+}
+
+// Rotates through input classes: scaled unit quaternions, wide exponent spread,
+// near-inverse pairs (cancellation in multiply), norms near epsilon, and exact edge values
+static void accuracy_inputs(uint64_t* state, size_t i, quaternion_t* a, quaternion_t* b) {
+    float* pa = &a->w;
+    float* pb = &b->w;
     
-    if (cipher_length < sizeof(hypercomplex_header_t)) {
-        return HC_ERROR_INVALID_DATA;
+    switch (i % 5) {
+    case 0: {
+        float sa = ldexpf(1.0f, (int)(bench_next_random(state) % 41) - 20);
+        float sb = ldexpf(1.0f, (int)(bench_next_random(state) % 41) - 20);
+        bench_random_quaternion(a, state);
+        bench_random_quaternion(b, state);
+        for (int c = 0; c < 4; c++) { pa[c] *= sa; pb[c] *= sb; }
+        break;
+    }
+    case 1:
+        for (int c = 0; c < 4; c++) {
+            pa[c] = accuracy_component(state, -60, 60);
+            pb[c] = accuracy_component(state, -60, 60);
+        }
+        break;
+    case 2: {
+        // b is a's inverse up to a tiny perturbation, so the product is nearly (1, 0, 0, 0)
+        bench_random_quaternion(a, state);
+        quaternion_t inv = { a->w, -a->x, -a->y, -a->z };
+        for (int c = 0; c < 4; c++) pb[c] = (&inv.w)[c] * (1.0f + bench_random_float(state) * 1e-6f);
+        break;
+    }
+    case 3: {
+        float s = 1e-6f * (1.5f + bench_random_float(state));
+        bench_random_quaternion(a, state);
+        bench_random_quaternion(b, state);
+        for (int c = 0; c < 4; c++) pa[c] *= s;
+        break;
+    }
+    default: {
+        static const float edges[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 3.0f, 0x1p-60f, 0x1p60f,
+                                       0x1.fffffep59f, 1.00000012f };
+        const size_t n = sizeof(edges) / sizeof(edges[0]);
+        for (int c = 0; c < 4; c++) {
+            pa[c] = edges[bench_next_random(state) % n];
+            pb[c] = edges[bench_next_random(state) % n];
+        }
+        break;
     }
+    }
+}
+
+static void accuracy_reference(hc_kernel_t kernel, const quaternion_t* qa, const quaternion_t* qb,
+                               accuracy_ref_t* ref) {
+    const long double a[4] = { qa->w, qa->x, qa->y, qa->z };
+    const long double b[4] = { qb->w, qb->x, qb->y, qb->z };
+    long double na = sqrtl(a[0] * a[0] + a[1] * a[1] + a[2] * a[2] + a[3] * a[3]);
+    long double nb = sqrtl(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
     
-    // Validate header
-    const hypercomplex_header_t* header = (const hypercomplex_header_t*)ciphertext;
-    if (header->magic != 0xDEADBEEF) {
-        return HC_ERROR_INVALID_DATA;
+    ref->skip = 0;
+    ref->scale = 0.0L;
+    
+    switch (kernel) {
+    case HC_KERNEL_MULTIPLY:
+        ref->c[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+        ref->c[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+        ref->c[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+        ref->c[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+        ref->scale = na * nb;
+        break;
+    case HC_KERNEL_ADD:
+        for (int c = 0; c < 4; c++) ref->c[c] = a[c] + b[c];
+        break;
+    case HC_KERNEL_CONJUGATE:
+        ref->c[0] = a[0];
+        for (int c = 1; c < 4; c++) ref->c[c] = -a[c];
+        break;
+    case HC_KERNEL_NORM:
+        ref->c[0] = na;
+        break;
+    default:
+        // Near the cut-off the float norm may land on either side of epsilon
+        ref->skip = na < 2.0L * norm_epsilon;
+        for (int c = 0; c < 4; c++) ref->c[c] = ref->skip ? 0.0L : a[c] / na;
+        break;
     }
+}
+
+// Accumulates one backend's errors over a chunk into r (sums in mean_ulp until the end)
+static void accuracy_score(hc_kernel_t kernel, const quaternion_t* out, const accuracy_ref_t* refs,
+                           size_t n, hc_accuracy_result_t* r) {
+    int components = (kernel == HC_KERNEL_NORM) ? 1 : 4;
     
-    if (*plain_length < header->length) {
-        *plain_length = header->length;
-        return HC_ERROR_INVALID_DATA;
+    for (size_t i = 0; i < n; i++) {
+        if (refs[i].skip) continue;
+        
+        const float* got = (kernel == HC_KERNEL_NORM) ? &((const float*)out)[i] : &out[i].w;
+        for (int c = 0; c < components; c++) {
+            long double ulp = accuracy_ulp(kernel == HC_KERNEL_MULTIPLY ? refs[i].scale : refs[i].c[c]);
+            long double err = fabsl((long double)got[c] - refs[i].c[c]) / ulp;
+            double e = isnan((double)err) ? INFINITY : (double)err;
+            
+            if (e > r->max_ulp[c]) r->max_ulp[c] = e;
+            r->mean_ulp[c] += e;
+        }
+        r->samples++;
     }
+}
+
+int hc_accuracy_check(size_t samples, uint64_t seed, hc_accuracy_result_t* results,
+                      size_t capacity, size_t* count) {
+    if (!results || !count) return HC_ERROR_NULL_PTR;
     
-    // For decryption, we'd need the inverse operation
-    // This is a simplified example - real decryption would require
-    // quaternion division or using the conjugate properly
+    *count = 0;
+    if (samples == 0) return HC_ERROR_INVALID_DATA;
     
-    size_t data_size = cipher_length - sizeof(hypercomplex_header_t);
-    const uint8_t* encrypted_data = (const uint8_t*)ciphertext + sizeof(hypercomplex_header_t);
+    // Lay out one result per available (kernel, backend) pair
+    for (int k = 0; k < HC_KERNEL_COUNT; k++) {
+        for (int be = 0; be < HC_BACKEND_COUNT && *count < capacity; be++) {
+            if (!backend_table[be][k]) continue;
+            
+            hc_accuracy_result_t* r = &results[(*count)++];
+            memset(r, 0, sizeof(*r));
+            r->kernel = (hc_kernel_t)k;
+            r->backend = (hc_backend_t)be;
+            r->bound_ulp = hc_accuracy_bound(r->kernel);
+        }
+    }
     
-    // Copy encrypted data to plaintext buffer for in-place decryption
-    memcpy(plaintext, encrypted_data, data_size);
+    quaternion_t* a = hc_aligned_alloc(ACCURACY_CHUNK * sizeof(quaternion_t), 64);
+    quaternion_t* b = hc_aligned_alloc(ACCURACY_CHUNK * sizeof(quaternion_t), 64);
+    quaternion_t* out = hc_aligned_alloc(ACCURACY_CHUNK * sizeof(quaternion_t), 64);
+    accuracy_ref_t* refs = malloc(ACCURACY_CHUNK * sizeof(accuracy_ref_t));
+    int ret = HC_ERROR_NO_MEMORY;
     
-    // Apply decryption (simplified - using conjugate of key)
-    quaternion_t inv_key;
-    quaternion_conjugate(&header->key, &inv_key);
+    if (a && b && out && refs) {
+        uint64_t state = seed;
+        
+        for (size_t done = 0; done < samples; done += ACCURACY_CHUNK) {
+            size_t n = samples - done < ACCURACY_CHUNK ? samples - done : ACCURACY_CHUNK;
+            
+            for (size_t i = 0; i < n; i++) accuracy_inputs(&state, done + i, &a[i], &b[i]);
+            
+            for (size_t j = 0; j < *count; j++) {
+                hc_accuracy_result_t* r = &results[j];
+                
+                // Results are grouped by kernel, so the reference is rebuilt once per kernel
+                if (j == 0 || results[j - 1].kernel != r->kernel) {
+                    for (size_t i = 0; i < n; i++) accuracy_reference(r->kernel, &a[i], &b[i], &refs[i]);
+                }
+                
+                memset(out, 0, n * sizeof(quaternion_t));
+                backend_table[r->backend][r->kernel](a, b, out, n);
+                accuracy_score(r->kernel, out, refs, n, r);
+            }
+        }
+        
+        ret = HC_SUCCESS;
+        for (size_t j = 0; j < *count; j++) {
+            hc_accuracy_result_t* r = &results[j];
+            
+            r->within_bound = 1;
+            for (int c = 0; c < 4; c++) {
+                if (r->samples) r->mean_ulp[c] /= (double)r->samples;
+                if (!(r->max_ulp[c] <= r->bound_ulp)) r->within_bound = 0;
+            }
+            if (!r->within_bound) ret = HC_ERROR_INVALID_DATA;
+        }
+    }
     
-    int result = hypercomplex_encrypt(plaintext, &inv_key, plaintext, data_size);
+    hc_aligned_free(a);
+    hc_aligned_free(b);
+    hc_aligned_free(out);
+    free(refs);
+    return ret;
+}
+
+int hc_accuracy_print(FILE* out, const hc_accuracy_result_t* results, size_t count) {
+    if (!out || (!results && count > 0)) return HC_ERROR_NULL_PTR;
     
-    if (result == HC_SUCCESS) {
-        *plain_length = header->length;
+    fprintf(out, "  %-10s %-8s %10s %23s %23s %6s\n",
+            "Kernel", "Backend", "samples", "max ulp (w x y z)", "mean ulp (w x y z)", "bound");
+    
+    for (size_t i = 0; i < count; i++) {
+        const hc_accuracy_result_t* r = &results[i];
         
-        // Verify checksum
-        uint32_t checksum = compute_checksum(plaintext, header->length);
-        if (checksum != header->checksum) {
-            return HC_ERROR_INVALID_DATA;
-        }
+        fprintf(out, "  %-10s %-8s %10zu  %5.2f %5.2f %5.2f %5.2f  %5.3f %5.3f %5.3f %5.3f %6.1f %s\n",
+                hc_kernel_name(r->kernel), hc_backend_name(r->backend), r->samples,
+                r->max_ulp[0], r->max_ulp[1], r->max_ulp[2], r->max_ulp[3],
+                r->mean_ulp[0], r->mean_ulp[1], r->mean_ulp[2], r->mean_ulp[3],
+                r->bound_ulp, r->within_bound ? "ok" : "EXCEEDED");
     }
     
-    return result;
+    return HC_SUCCESS;
 }
 
-int hypercomplex_benchmark(size_t iterations, perf_stats_t* stats) {
-    if (!stats) return HC_ERROR_NULL_PTR;
+/*
+ * Autotuning
+ */
+
+#define TUNE_LARGE_ELEMENTS ((size_t)1 << 19)   // 8 MB per array, past most LLCs
+
+typedef struct {
+    const quaternion_t* a;
+    const quaternion_t* b;
+    quaternion_t* out;
+    size_t elements;
+    const hc_tuning_t* candidate;
+} tune_job_t;
+
+// Runs the batch kernels under the candidate; the published tuning is never touched
+static void tune_body(void* arg, size_t passes) {
+    tune_job_t* job = (tune_job_t*)arg;
+    
+    for (size_t p = 0; p < passes; p++) {
+        batch_dispatch_tuned(job->candidate, HC_KERNEL_MULTIPLY, job->a, job->b, job->out, job->elements);
+        batch_dispatch_tuned(job->candidate, HC_KERNEL_NORMALIZE, job->out, NULL, job->out, job->elements);
+    }
+    bench_escape(job->out);
+}
+
+// Median ns per element for the batch kernels under a candidate tuning
+static double tune_measure(const hc_tuning_t* candidate, const hc_bench_config_t* config,
+                           tune_job_t* job, size_t passes) {
+    perf_stats_t stats;
+    hc_bench_config_t quiet = *config;
+    quiet.hw_counters = 0;
     
-    quaternion_t q1, q2, result;
-    quaternion_init(&q1, 1.0f, 2.0f, 3.0f, 4.0f);
-    quaternion_init(&q2, 0.5f, 1.5f, 2.5f, 3.5f);
+    job->candidate = candidate;
+    tune_body(job, 1);
+    if (bench_measure(tune_body, job, &quiet, passes, job->elements, 0, &stats) != HC_SUCCESS) return INFINITY;
     
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
+    return stats.median_ns;
+}
+
+int hc_autotune(const hc_bench_config_t* config, hc_tuning_t* best) {
+    if (!best) return HC_ERROR_NULL_PTR;
     
-    for (size_t i = 0; i < iterations; i++) {
-        quaternion_multiply(&q1, &q2, &result);
+    hc_bench_config_t defaults;
+    if (!config) {
+        hc_bench_default_config(&defaults);
+        config = &defaults;
     }
+    if (config->repetitions == 0) return HC_ERROR_INVALID_DATA;
+    
+    size_t bytes = TUNE_LARGE_ELEMENTS * sizeof(quaternion_t);
+    quaternion_t* a = hc_aligned_alloc(bytes, 64);
+    quaternion_t* b = hc_aligned_alloc(bytes, 64);
+    quaternion_t* out = hc_aligned_alloc(bytes, 64);
+    int ret = HC_ERROR_NO_MEMORY;
     
-    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (a && b && out) {
+        uint64_t state = config->seed;
+        for (size_t i = 0; i < TUNE_LARGE_ELEMENTS; i++) {
+            bench_random_quaternion(&a[i], &state);
+            bench_random_quaternion(&b[i], &state);
+        }
+        
+        hc_tuning_t candidate;
+        hc_tuning_default(&candidate);
+        *best = candidate;
+        
+        // Backend, single-threaded on an L1-resident batch
+        tune_job_t small = { a, b, out, HC_BENCH_BATCH_COUNT, NULL };
+        double best_ns = INFINITY;
+        for (int be = HC_BACKEND_AUTOVEC; be < HC_BACKEND_COUNT; be++) {
+            candidate.batch_backend = (hc_backend_t)be;
+            if (!tuning_valid(&candidate)) continue;
+            
+            double ns = tune_measure(&candidate, config, &small, 64);
+            if (ns < best_ns) {
+                best_ns = ns;
+                best->batch_backend = candidate.batch_backend;
+            }
+        }
+        candidate.batch_backend = best->batch_backend;
+        
+        // Threads and chunk size on a memory-bound batch; extra threads must win by 5%
+        static const size_t chunks[] = { 4096, 16384, 65536 };
+        tune_job_t large = { a, b, out, TUNE_LARGE_ELEMENTS, NULL };
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        unsigned max_threads = cpus > HC_MAX_THREADS ? HC_MAX_THREADS : cpus > 1 ? (unsigned)cpus : 1;
+        
+        best_ns = INFINITY;
+        for (unsigned threads = 1; ; threads *= 2) {
+            if (threads > max_threads) threads = max_threads;
+            
+            for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+                candidate.threads = threads;
+                candidate.chunk_elements = threads > 1 ? chunks[c] : best->chunk_elements;
+                
+                double ns = tune_measure(&candidate, config, &large, 1);
+                if (ns < best_ns * (threads > best->threads ? 0.95 : 1.0)) {
+                    best_ns = ns;
+                    best->threads = threads;
+                    best->chunk_elements = candidate.chunk_elements;
+                }
+                if (threads == 1) break;             // Chunking is moot without helpers
+            }
+            if (threads == max_threads) break;
+        }
+        
+        // Streaming stores on the same batch, kept for outputs past the LLC if they win by 5%
+        candidate = *best;
+        double cached_ns = tune_measure(&candidate, config, &large, 1);
+        candidate.nt_threshold_bytes = sizeof(quaternion_t);
+        if (tune_measure(&candidate, config, &large, 1) < cached_ns * 0.95) {
+            size_t llc = hc_cache_size(3);
+            best->nt_threshold_bytes = llc ? llc : bytes;
+        }
+        
+        ret = HC_SUCCESS;
+    }
     
-    uint64_t elapsed_ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + 
-                         (end.tv_nsec - start.tv_nsec);
+    hc_aligned_free(a);
+    hc_aligned_free(b);
+    hc_aligned_free(out);
+    if (ret == HC_SUCCESS) hc_tuning_set(best);
+    return ret;
+}
+
+int hypercomplex_benchmark(size_t iterations, perf_stats_t* stats) {
+    if (!stats) return HC_ERROR_NULL_PTR;
     
-    stats->operations_per_second = (iterations * 1000000000ULL) / elapsed_ns;
-    stats->average_latency_ns = (double)elapsed_ns / iterations;
-    stats->bytes_processed = iterations * sizeof(quaternion_t) * 2;
+    hc_bench_config_t config;
+    hc_bench_default_config(&config);
+    config.iterations = iterations;
+    config.repetitions = 1;
+    config.warmup = iterations / 10;
     
-    return HC_SUCCESS;
+    return hc_bench_run(HC_OP_MULTIPLY, HC_BENCH_THROUGHPUT, &config, stats);
 }
 
 /*
@@ -289,17 +7260,36 @@ int hypercomplex_benchmark(size_t iterations, perf_stats_t* stats) {
 
 CC = gcc
 AS = as
-CFLAGS = -O3 -Wall -Wextra -std=c11 -march=armv8-a
+ARCH ?= $(shell uname -m)
 ASFLAGS = -march=armv8-a
-LDFLAGS = -lm
+LDFLAGS = -lm -lpthread
+
+# Other hosts build the portable C core in place of hypercomplex.s
+ifeq ($(ARCH),aarch64)
+CFLAGS = -O3 -Wall -Wextra -std=c11 -march=armv8-a
+CXXFLAGS = -O3 -Wall -Wextra -std=c++20 -march=armv8-a
+ASM_SOURCES = hypercomplex.s
+else
+CFLAGS = -O3 -Wall -Wextra -std=c11 -march=native
+CXXFLAGS = -O3 -Wall -Wextra -std=c++20 -march=native
+ASM_SOURCES =
+endif
+
+CROSS ?= aarch64-linux-gnu-
+QEMU ?= qemu-aarch64 -L /usr/aarch64-linux-gnu
 
 TARGET = hypercomplex_test
+BASELINE ?= bench_baseline.csv
+THRESHOLD ?= 5
 SOURCES = hypercomplex.c test_hypercomplex.c
-ASM_SOURCES = hypercomplex.s
 OBJECTS = $(SOURCES:.c=.o) $(ASM_SOURCES:.s=.o)
 HEADERS = hypercomplex.h
+CXX_TARGET = hypercomplex_cxx_test
+CXX_OBJECTS = test_hypercomplex_cxx.o hypercomplex.o $(ASM_SOURCES:.s=.o)
+STATS_TARGET = hypercomplex_stats_test
+STATS_OBJECTS = $(SOURCES:.c=.stats.o) $(ASM_SOURCES:.s=.o)
 
-.PHONY: all clean test benchmark
+.PHONY: all clean test test-stats cxx-test benchmark sweep bench-baseline bench-compare bench-backends roofline accuracy autotune probes cxx-check sweep-hugepages sweep-nt qemu-check
 
 all: $(TARGET)
 
@@ -312,14 +7302,88 @@ $(TARGET): $(OBJECTS)
 %.o: %.s
 	$(AS) $(ASFLAGS) $< -o $@
 
-test: $(TARGET)
+$(CXX_TARGET): $(CXX_OBJECTS)
+	$(CXX) $(CXX_OBJECTS) -o $@ $(LDFLAGS)
+
+%.o: %.cpp $(HEADERS)
+	$(CXX) $(CXXFLAGS) -c $< -o $@
+
+# The statistics, flight recorder and exporter compile to stubs without HC_ENABLE_STATS,
+# so a second build with it on runs their real tests
+$(STATS_TARGET): $(STATS_OBJECTS)
+	$(CC) $(STATS_OBJECTS) -o $@ $(LDFLAGS)
+
+%.stats.o: %.c $(HEADERS)
+	$(CC) $(CFLAGS) -DHC_ENABLE_STATS -c $< -o $@
+
+test: $(TARGET) test-stats
 	./$(TARGET) --test
 
+test-stats: $(STATS_TARGET)
+	./$(STATS_TARGET) --test
+
 benchmark: $(TARGET)
 	./$(TARGET) --benchmark
 
+sweep: $(TARGET)
+	./$(TARGET) --sweep
+
+# Same sweep on 4 KB and on transparent huge pages; compare the dTLB/1k column
+sweep-hugepages: $(TARGET)
+	./$(TARGET) --sweep --huge-pages off
+	./$(TARGET) --sweep --huge-pages thp
+
+# Same sweep with cached stores and with streaming stores past 16 MB
+sweep-nt: $(TARGET)
+	./$(TARGET) --sweep --nt-threshold 0
+	./$(TARGET) --sweep --nt-threshold 16777216
+
+# Capture a baseline before a change, then gate the new build against it
+bench-baseline: $(TARGET)
+	./$(TARGET) --benchmark --save-baseline $(BASELINE)
+
+bench-compare: $(TARGET)
+	./$(TARGET) --benchmark --baseline $(BASELINE) --threshold $(THRESHOLD)
+
+bench-backends: $(TARGET)
+	./$(TARGET) --backends
+
+roofline: $(TARGET)
+	./$(TARGET) --roofline --csv roofline.csv
+
+accuracy: $(TARGET)
+	./$(TARGET) --accuracy
+
+# Writes ~/.config/hypercomplex/<host>.conf; run once per host as the user the service runs as
+autotune: $(TARGET)
+	./$(TARGET) --autotune
+
+# The C++ section of the header is header-only; its static_asserts run at compile time
+cxx-check:
+	$(CXX) -std=c++17 -Wall -Wextra -fsyntax-only -x c++ $(HEADERS)
+	$(CXX) -std=c++20 -Wall -Wextra -fsyntax-only -x c++ $(HEADERS)
+
+# Runs the C++ interface: coroutines resumed from the pool, fixed-size kernels
+cxx-test: $(CXX_TARGET)
+	./$(CXX_TARGET)
+
+# Lists the USDT probes compiled in (needs <sys/sdt.h> from systemtap-sdt-dev at build time)
+probes: $(TARGET)
+	readelf -n $(TARGET) | grep -A1 stapsdt | grep Name:
+
+# Cross-build for aarch64 and check the asm and NEON backends under qemu; its timings mean nothing
+qemu-check: clean
+	$(MAKE) ARCH=aarch64 CC=$(CROSS)gcc CXX=$(CROSS)g++ AS=$(CROSS)as all $(CXX_TARGET)
+	$(QEMU) ./$(TARGET) --test
+	$(MAKE) ARCH=aarch64 CC=$(CROSS)gcc AS=$(CROSS)as $(STATS_TARGET)
+	$(QEMU) ./$(STATS_TARGET) --test
+	$(QEMU) ./$(CXX_TARGET)
+	$(QEMU) ./$(TARGET) --backends 10240 --repetitions 1
+	$(QEMU) ./$(TARGET) --accuracy 1000000
+	$(MAKE) clean
+
 clean:
-	rm -f $(OBJECTS) $(TARGET)
+	rm -f $(OBJECTS) $(TARGET) test_hypercomplex_cxx.o $(CXX_TARGET) $(SOURCES:.c=.stats.o) $(STATS_TARGET)
 
 install: $(TARGET)
 	cp $(TARGET) /usr/local/bin/